@@ -5,7 +5,16 @@
 #include "player.hpp"
 #include "grid.hpp"
 #include "starfield.hpp"
+#include "minimap.hpp"
 #include "render_command.hpp"
+#include "render_batch.hpp"
+#include "sprite_atlas.hpp"
+#include "input_recorder.hpp"
+#include "remote_world.hpp"
+#include "particle_system.hpp"
+#include "quality_governor.hpp"
+#include "memory_tracker.hpp"
+#include <string>
 #include <vector>
 
 class Application
@@ -15,6 +24,18 @@ public:
     void shutdown();
     void update();
     void render();
+
+    // Record the input of this run, or replay a recording with its seed (call before initialize)
+    bool recordInput(const std::string& path);
+    bool replayInput(const std::string& path);
+    bool isReplayFinished() const { return m_input.isPlaybackFinished(); }
+
+    // Render the world simulated by a server at "host[:port]" instead of simulating it (call before initialize)
+    void connectToServer(const std::string& address) { m_serverAddress = address; }
+    bool isDisconnected() const { return !m_serverAddress.empty() && !m_remote.isConnected(); }
+
+    // CPU time per frame the quality governor aims for, 0 keeps the full quality (call before initialize)
+    void setFrameBudget(double milliseconds) { m_frameBudget = milliseconds; }
     
 private:
     int m_width = 1920;
@@ -22,21 +43,61 @@ private:
 
     Vector2 m_worldSize = { 10000, 10000 };
     
-    GameCamera m_camera;
+    // A camera together with the render commands collected for it.
+    // View 0 is the main camera following the player, further views
+    // (spectator, split-screen) are culled in the same grid traversal
+    struct CameraView
+    {
+        GameCamera camera;
+        RenderCommandList renderCommands; // Rendering Command Queue
+    };
+
+    std::vector<CameraView> m_views;
+    TrackedUsage<MemorySubsystem::RenderCommands> m_commandUsage;
     Player m_player;
-    Grid m_grid;
+    WorldGrid m_grid;
     Starfield m_starfield;
+    Minimap m_minimap;
+    ParticleSystem m_particles;
+    bool m_playerAtBoundary = false;
+
+    static const int MAX_PARTICLES = 32768;
+    static const int PARTICLE_LAYER = 9;    // Above every asteroid, below the player
     
-    // Rendering Command Queue
-    std::vector<RenderCommand> m_renderCommands;
+    // Shared culling pass: one frustum and one visible list per view
+    std::vector<Rectangle> m_frusta;
+    std::vector<std::vector<Asteroid>> m_visiblePerView;
+    RenderBatch m_renderBatch;
+    SpriteAtlas m_atlas;
     
+    // Input source and frame time capture
+    InputRecorder m_input;
+    double m_frameStartTime = 0.0;
+
+    // Sheds background detail when frames take longer than the budget
+    QualityGovernor m_governor;
+    double m_frameBudget = QualityGovernor::DEFAULT_BUDGET_MS;
+
+    // Server the world comes from, empty for a local simulation
+    std::string m_serverAddress;
+    RemoteWorld m_remote;
+
     // Debug information
     bool m_showDebug = true;
     int m_totalAsteroids = 0;
     int m_visibleAsteroids = 0;
+    bool m_showOverdraw = false;    // Depth-tested overdraw heatmap instead of the scene
+    float m_submittedCoverage = 0.0f;   // Average primitives submitted per pixel of the main view, before the depth test
+    int m_reducedAsteroids = 0;     // Drawn below the LOD threshold in the main view
     
     void processInput();
     void updateCamera();
+    void toggleSpectatorView();
+    void emitThrust();
+    void updateEffects(float deltaTime);
+    void applyQualitySettings();
     void collectRenderCommands();
+    void renderView(const CameraView& view, bool isMainView);
+    void addPlayer(const RenderCommand& cmd, const GameCamera& camera, bool isMainView);
     void renderDebugInfo();
 };
\ No newline at end of file
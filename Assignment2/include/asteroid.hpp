@@ -7,7 +7,7 @@ class Asteroid
 {
 public:
     void initialize(Vector2 position, Vector2 size, float rotation, 
-                   float rotationSpeed, Color color, int layer);
+                   float rotationSpeed, Color color, int layer, unsigned char shapeId);
     void update();
     
     Vector2 position;
@@ -15,5 +15,9 @@ public:
     float rotation;
     float rotationSpeed;
     Color color;
-    int layer;
-};
\ No newline at end of file
+    unsigned char layer;
+    unsigned char shapeId;  // Template in AsteroidShapes
+};
+
+// The shape index fits in the padding after the layer, asteroids stay at 32 bytes
+static_assert(sizeof(Asteroid) == 32, "Asteroid grew, check the grid memory budget");
\ No newline at end of file
@@ -0,0 +1,28 @@
+// asteroid_shapes.hpp
+
+#pragma once
+#include <raylib.h>
+
+// Irregular asteroid outlines shared by all asteroids. Each size class has a few
+// template polygons, generated once; an asteroid only stores the byte index of its
+// template and the renderer scales and rotates the template per instance.
+namespace AsteroidShapes
+{
+    const int SIZE_CLASSES = 3;
+    const int SHAPES_PER_SIZE = 4;
+    const int SHAPE_COUNT = SIZE_CLASSES * SHAPES_PER_SIZE;
+    const int VERTEX_COUNT = 8;
+
+    // Vertices in clockwise screen order around the center, inside the unit circle
+    // (scaled by the half size of the asteroid)
+    struct Shape
+    {
+        Vector2 vertices[VERTEX_COUNT];
+        float area;     // Area of the polygon for a half size of 1
+    };
+
+    const Shape& get(unsigned char shapeId);
+
+    // Random template of a size class (0 small to SIZE_CLASSES - 1 large)
+    unsigned char pick(int sizeClass);
+};
\ No newline at end of file
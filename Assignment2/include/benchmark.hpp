@@ -0,0 +1,15 @@
+// benchmark.hpp
+
+#pragma once
+#include <string>
+
+// Microbenchmarks for the building blocks of the renderer. Sweeps asteroid count,
+// grid cell size and viewport size, and writes one CSV row per measurement:
+//   benchmark, asteroids, cell_size, viewport_w, viewport_h, iterations,
+//   ns_per_iteration, objects_per_ns, cells_visited, cache_misses
+// cells_visited is the average per query, cache_misses is -1 where perf_event
+// is not available. Runs without a window.
+namespace Benchmark
+{
+    int run(const std::string& outputPath);
+};
\ No newline at end of file
@@ -9,7 +9,13 @@ public:
     void initialize(Vector2 position, Vector2 viewportSize, Vector2 worldSize, Vector2 screenSize);
     void update(Vector2 targetPosition);
 
+    // Center the camera on a world position while keeping its frame fixed on screen
+    void lookAt(Vector2 position);
+
     void setPosition(Vector2 position) { m_position = position; }
+
+    // Take over the position and frame of another camera with the same viewport
+    void setState(Vector2 position, Rectangle cameraFrame);
     Vector2 getPosition() const { return m_position; }
 
     Rectangle getFrustum() const { return m_frustum; }
@@ -17,6 +23,10 @@ public:
 
     // Get the position and size of the camera frame on the screen
     Rectangle getCameraFrame() const { return m_cameraFrame; }
+    void setCameraFrame(Rectangle cameraFrame) { m_cameraFrame = cameraFrame; }
+
+    // Convert world coordinates to screen coordinates within the camera frame
+    Vector2 worldToScreen(Vector2 position) const;
 
     void renderDebug() const;
 
@@ -31,5 +41,6 @@ private:
     Rectangle m_cameraFrame = { 0, 0, 0, 0 };
 
     void clampToWorldBounds();
+    void updateFrustum();
     void updateCameraFrame(Vector2 targetPosition); // Update camera frame position
 };
\ No newline at end of file
@@ -3,38 +3,114 @@
 #pragma once
 #include "asteroid.hpp"
 #include "game_camera.hpp"
+#include "grid_indexer.hpp"
+#include "memory_tracker.hpp"
 #include <vector>
 #include <raylib.h>
 
 struct GridCell
 {
-    std::vector<Asteroid> asteroids;
+    TrackedVector<Asteroid, MemorySubsystem::GridCells> asteroids;
 };
 
-class Grid
+// Work done by the last visibility query
+struct GridQueryStats
+{
+    int cellsVisited = 0;
+    int asteroidsTested = 0;
+};
+
+// Uniform grid of asteroid cells. The cell lookup is provided by CellIndexer, either
+// configured at runtime (Grid) or fixed at compile time with power-of-two cells (StaticGrid).
+template <typename CellIndexer>
+class BasicGrid
 {
 public:
-    void initialize(int width, int height, int cellWidth, int cellHeight, int screen_width, int screen_height);
+    using Indexer = CellIndexer;
+
+    // Asteroid ids pack the cell index and the slot in the cell into 32 bits
+    static constexpr int ASTEROID_SLOT_BITS = 20;
+    static constexpr int MAX_CELLS = 1 << (32 - ASTEROID_SLOT_BITS);
+    static constexpr int MAX_ASTEROIDS_PER_CELL = 1 << ASTEROID_SLOT_BITS;
+
+    // False if the grid has more than MAX_CELLS cells
+    bool initialize(int width, int height, int cellWidth, int cellHeight, int screen_width, int screen_height);
+
+    // Asteroids that would exceed MAX_ASTEROIDS_PER_CELL in their cell are dropped
     void generateAsteroids(int count);
     void updateAsteroids();
     
     std::vector<Asteroid> getVisibleAsteroids(const Rectangle& frustum) const;
+
+    // Cull against several frusta in a single traversal of the grid. Each asteroid is
+    // tagged with a mask of the cameras that see it and appended to those cameras' lists.
+    // At most MAX_CAMERAS frusta are supported.
+    static constexpr int MAX_CAMERAS = 32;
+    void getVisibleAsteroids(const std::vector<Rectangle>& frusta,
+                             std::vector<std::vector<Asteroid>>& visiblePerCamera) const;
+
+    // Same traversal, but returns the ids of the visible asteroids in increasing order.
+    // Asteroids never change cells, so an id (cell index and slot in the cell) stays valid.
+    void getVisibleAsteroidIds(const std::vector<Rectangle>& frusta,
+                               std::vector<std::vector<unsigned int>>& idsPerCamera) const;
+    const Asteroid& getAsteroid(unsigned int id) const;
     
     void renderDebug(const GameCamera& camera) const;
+
+    int getWidth() const { return m_indexer.width(); }
+    int getHeight() const { return m_indexer.height(); }
+    int getCellWidth() const { return m_indexer.cellWidth(); }
+    int getCellHeight() const { return m_indexer.cellHeight(); }
+    int getAsteroidCount(int cellIndex) const { return (int)m_cells[cellIndex].asteroids.size(); }
+
+    const GridQueryStats& getLastQueryStats() const { return m_lastQueryStats; }
+
+    // Bytes of the cells and the asteroids stored in them, without the capacity slack
+    size_t getUsedBytes() const;
+
+    // Move the indices of cells whose asteroid count changed since the last call into dirtyCells
+    void takeDirtyCells(std::vector<int>& dirtyCells);
     
 private:
-    int m_width = 0;
-    int m_height = 0;
-    int m_cellWidth = 0;
-    int m_cellHeight = 0;
+    CellIndexer m_indexer;
     int m_screen_width;
     int m_screen_height;
     
-    std::vector<GridCell> m_cells;
+    TrackedVector<GridCell, MemorySubsystem::GridCells> m_cells;
+    TrackedUsage<MemorySubsystem::GridCells> m_usage;
+
+    mutable GridQueryStats m_lastQueryStats;
+
+    // Cells whose asteroid count changed, each listed once
+    std::vector<int> m_dirtyCells;
+    std::vector<bool> m_cellDirty;
+
+    void markCellDirty(int index);
+
+    // Single traversal behind the multi-frustum queries, calls
+    // visit(camera, cellIndex, slot, asteroid) for each camera that sees an asteroid
+    template <typename Visitor>
+    void visitVisible(const std::vector<Rectangle>& frusta, Visitor visit) const;
     
     // Convert world coordinates to grid coordinates
     void worldToGrid(const Vector2& position, int& gridX, int& gridY) const;
     
     // Check if the grid cells are inside the cone of sight
     bool isCellVisible(int gridX, int gridY, const Rectangle& frustum) const;
-};
\ No newline at end of file
+};
+
+// Grid configured at runtime
+using Grid = BasicGrid<RuntimeCellIndexer>;
+
+// Grid with 10x10 cells of 1024x1024 world units fixed at compile time
+using StaticGrid = BasicGrid<Pow2CellIndexer<10, 10, 10>>;
+
+// Grid used by the application, define USE_STATIC_GRID to select the compile-time configuration
+#ifdef USE_STATIC_GRID
+using WorldGrid = StaticGrid;
+const int WORLD_CELL_SIZE = 1024;
+#else
+using WorldGrid = Grid;
+const int WORLD_CELL_SIZE = 1000;
+#endif
+const int WORLD_CELL_COUNT = 10;
\ No newline at end of file
@@ -0,0 +1,76 @@
+// grid_indexer.hpp
+
+#pragma once
+#include <array>
+
+// Cell lookup for a grid configured at runtime: integer division by the cell size
+class RuntimeCellIndexer
+{
+public:
+    bool configure(int width, int height, int cellWidth, int cellHeight)
+    {
+        m_width = width;
+        m_height = height;
+        m_cellWidth = cellWidth;
+        m_cellHeight = cellHeight;
+        return true;
+    }
+
+    int width() const { return m_width; }
+    int height() const { return m_height; }
+    int cellWidth() const { return m_cellWidth; }
+    int cellHeight() const { return m_cellHeight; }
+
+    // World coordinate to cell column/row (not clamped to the grid)
+    int cellX(int worldX) const { return worldX / m_cellWidth; }
+    int cellY(int worldY) const { return worldY / m_cellHeight; }
+
+    int cellIndex(int gridX, int gridY) const { return gridY * m_width + gridX; }
+
+private:
+    int m_width = 0;
+    int m_height = 0;
+    int m_cellWidth = 0;
+    int m_cellHeight = 0;
+};
+
+// Cell lookup for a grid whose square cells of (1 << CellShift) world units and
+// dimensions are known at compile time: cell lookup is a shift and the row
+// offsets come from a constexpr table
+template <int CellShift, int Width, int Height>
+class Pow2CellIndexer
+{
+public:
+    static constexpr int CELL_SIZE = 1 << CellShift;
+
+    // The dimensions are fixed, only report whether the requested ones match
+    bool configure(int width, int height, int cellWidth, int cellHeight) const
+    {
+        return width == Width && height == Height && cellWidth == CELL_SIZE && cellHeight == CELL_SIZE;
+    }
+
+    static constexpr int width() { return Width; }
+    static constexpr int height() { return Height; }
+    static constexpr int cellWidth() { return CELL_SIZE; }
+    static constexpr int cellHeight() { return CELL_SIZE; }
+
+    // Arithmetic shift rounds negative coordinates down instead of toward zero,
+    // callers clamp to the grid either way
+    static constexpr int cellX(int worldX) { return worldX >> CellShift; }
+    static constexpr int cellY(int worldY) { return worldY >> CellShift; }
+
+    static constexpr int cellIndex(int gridX, int gridY) { return ROW_OFFSETS[gridY] + gridX; }
+
+private:
+    static constexpr std::array<int, Height> makeRowOffsets()
+    {
+        std::array<int, Height> offsets = {};
+        for (int y = 0; y < Height; y++)
+        {
+            offsets[y] = y * Width;
+        }
+        return offsets;
+    }
+
+    static constexpr std::array<int, Height> ROW_OFFSETS = makeRowOffsets();
+};
\ No newline at end of file
@@ -0,0 +1,72 @@
+// input_recorder.hpp
+
+#pragma once
+#include <string>
+#include <vector>
+
+// Player input of one simulation tick
+enum InputFlags : unsigned char
+{
+    INPUT_THRUST = 1 << 0,
+    INPUT_ROTATE_LEFT = 1 << 1,
+    INPUT_ROTATE_RIGHT = 1 << 2,
+    INPUT_TOGGLE_DEBUG = 1 << 3,
+    INPUT_TOGGLE_SPECTATOR = 1 << 4,
+    INPUT_TOGGLE_OVERDRAW = 1 << 5,
+
+    // Flags that steer the player, the rest only change the local display
+    INPUT_PLAYER_CONTROLS = INPUT_THRUST | INPUT_ROTATE_LEFT | INPUT_ROTATE_RIGHT
+};
+
+// Reads the input for each simulation tick, either live from the keyboard or from a
+// recording. While recording or replaying the simulation runs with a fixed timestep
+// and a fixed random seed, so a replay traverses the world exactly like the recorded
+// run and its frame times can be compared between builds.
+class InputRecorder
+{
+public:
+    enum class Mode
+    {
+        Live,
+        Record,
+        Playback
+    };
+
+    static constexpr unsigned int DEFAULT_SEED = 5814;
+    static constexpr float FIXED_TIMESTEP = 1.0f / 60.0f;
+
+    bool startRecording(const std::string& path, unsigned int seed = DEFAULT_SEED);
+    bool startPlayback(const std::string& path);
+
+    Mode getMode() const { return m_mode; }
+    bool isDeterministic() const { return m_mode != Mode::Live; }
+    unsigned int getSeed() const { return m_seed; }
+
+    // Input flags of the next tick
+    unsigned char nextTick();
+
+    // Simulation timestep of the current tick
+    float getTimestep() const;
+
+    bool isPlaybackFinished() const { return m_mode == Mode::Playback && m_tick >= (int)m_ticks.size(); }
+
+    // Capture the CPU time spent on the current frame and the full frame time
+    void recordFrameTime(double workSeconds, float frameSeconds);
+
+    // Write the recording and the frame time report
+    void finish();
+
+private:
+    Mode m_mode = Mode::Live;
+    std::string m_path;
+    unsigned int m_seed = 0;
+
+    std::vector<unsigned char> m_ticks;
+    int m_tick = 0;
+
+    std::vector<float> m_workTimes;     // Milliseconds
+    std::vector<float> m_frameTimes;    // Milliseconds
+
+    unsigned char pollKeyboard() const;
+    void writeFrameTimes() const;
+};
\ No newline at end of file
@@ -0,0 +1,12 @@
+// loopback.hpp
+
+#pragma once
+
+// Runs the simulation server and a number of headless clients with different viewport
+// sizes in one process over localhost. Checks after every snapshot that each client
+// holds exactly the asteroids a local grid culls for its camera, and prints bandwidth
+// per client and server work per tick. Returns 0 if every snapshot matched.
+namespace Loopback
+{
+    int run(int clientCount, int tickCount);
+};
\ No newline at end of file
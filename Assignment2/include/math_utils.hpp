@@ -17,4 +17,11 @@ namespace MathUtils
     float easeOut(float t);
 
     float clamp(float value, float min, float max);
+
+    // Table-based sine/cosine for the render loop (angle in radians)
+    // Linear interpolation between 4096 samples keeps the error below 1e-6
+    void fastSinCos(float radians, float& sine, float& cosine);
+
+    // Largest absolute difference between fastSinCos and sinf/cosf over a full turn
+    float fastSinCosMaxError();
 };
\ No newline at end of file
@@ -0,0 +1,113 @@
+// memory_tracker.hpp
+
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <ostream>
+#include <vector>
+
+// Subsystems whose containers allocate through TrackedAllocator
+enum class MemorySubsystem
+{
+    GridCells,          // Cell array and the asteroids of every cell
+    Stars,              // Star list and per-tile star ranges
+    RenderCommands,     // Per-view render command queues
+    Count
+};
+
+// Footprint of one subsystem in bytes
+struct MemoryStats
+{
+    long long usedBytes = 0;        // Elements actually stored, reported by the owners
+    long long reservedBytes = 0;    // Capacity currently allocated
+    long long peakReservedBytes = 0;
+    long long allocations = 0;
+    long long deallocations = 0;
+};
+
+// Process-wide counters per subsystem. The allocator only sees capacities, so the
+// reserved bytes, peak and allocation counts are exact while every owner of tracked
+// containers adds its used bytes (see TrackedUsage). Both sum over the same live
+// containers, so reserved minus used is the capacity slack.
+// Counters are atomic, grids are also built on the server thread of a loopback run.
+namespace MemoryTracker
+{
+    void recordAllocation(MemorySubsystem subsystem, size_t bytes);
+    void recordDeallocation(MemorySubsystem subsystem, size_t bytes);
+    void addUsedBytes(MemorySubsystem subsystem, size_t bytes);
+    void removeUsedBytes(MemorySubsystem subsystem, size_t bytes);
+
+    MemoryStats getStats(MemorySubsystem subsystem);
+    const char* getName(MemorySubsystem subsystem);
+
+    // One line per subsystem plus the total
+    void report(std::ostream& out);
+
+    // Bytes held by the elements of a container
+    template <typename Container>
+    size_t usedBytes(const Container& container)
+    {
+        return container.size() * sizeof(typename Container::value_type);
+    }
+}
+
+// std::allocator that counts its allocations against a subsystem
+template <typename T, MemorySubsystem Subsystem>
+class TrackedAllocator
+{
+public:
+    using value_type = T;
+
+    // The subsystem is a non-type parameter, std::allocator_traits cannot rebind it on its own
+    template <typename U>
+    struct rebind
+    {
+        using other = TrackedAllocator<U, Subsystem>;
+    };
+
+    TrackedAllocator() = default;
+
+    template <typename U>
+    TrackedAllocator(const TrackedAllocator<U, Subsystem>&) {}
+
+    T* allocate(size_t count)
+    {
+        T* memory = std::allocator<T>().allocate(count);
+        MemoryTracker::recordAllocation(Subsystem, count * sizeof(T));
+        return memory;
+    }
+
+    void deallocate(T* memory, size_t count)
+    {
+        MemoryTracker::recordDeallocation(Subsystem, count * sizeof(T));
+        std::allocator<T>().deallocate(memory, count);
+    }
+
+    template <typename U>
+    bool operator==(const TrackedAllocator<U, Subsystem>&) const { return true; }
+};
+
+template <typename T, MemorySubsystem Subsystem>
+using TrackedVector = std::vector<T, TrackedAllocator<T, Subsystem>>;
+
+// Used bytes one owner contributes to a subsystem, withdrawn when the owner is destroyed.
+// A copy contributes the same bytes again, like the copied containers reserve them again
+template <MemorySubsystem Subsystem>
+class TrackedUsage
+{
+public:
+    TrackedUsage() = default;
+    TrackedUsage(const TrackedUsage& other) { set(other.m_bytes); }
+    TrackedUsage& operator=(const TrackedUsage& other) { set(other.m_bytes); return *this; }
+    ~TrackedUsage() { set(0); }
+
+    void set(size_t bytes)
+    {
+        MemoryTracker::removeUsedBytes(Subsystem, m_bytes);
+        MemoryTracker::addUsedBytes(Subsystem, bytes);
+        m_bytes = bytes;
+    }
+
+private:
+    size_t m_bytes = 0;
+};
\ No newline at end of file
@@ -0,0 +1,44 @@
+// minimap.hpp
+
+#pragma once
+#include "grid.hpp"
+#include "game_camera.hpp"
+#include <vector>
+#include <raylib.h>
+
+// Minimap showing asteroid density per grid cell, the camera frustum and the player.
+// Density lives in a texture with one texel per cell that is only updated for cells
+// that changed; background, density and grid lines are cached in a render texture
+// that is drawn as a single textured quad each frame.
+class Minimap
+{
+public:
+    void initialize(const WorldGrid& grid, Rectangle screenRect);
+    void shutdown();
+
+    // Upload changed cells and rebuild the cached minimap if anything changed
+    void update(WorldGrid& grid);
+
+    // Same for counts that come from elsewhere (a server), one per grid cell in index order
+    void setCellCounts(const std::vector<int>& cellCounts);
+
+    void render(const GameCamera& camera, Vector2 playerPosition) const;
+
+private:
+    Rectangle m_screenRect = { 0, 0, 0, 0 };
+    Vector2 m_worldSize = { 0, 0 };
+    int m_gridWidth = 0;
+    int m_gridHeight = 0;
+
+    Texture2D m_densityTexture = {};   // One texel per grid cell
+    RenderTexture2D m_cache = {};      // Background, density and grid lines
+
+    std::vector<int> m_cellCounts;
+    std::vector<Color> m_densityPixels;
+    std::vector<int> m_dirtyCells;
+    int m_maxCount = 1;
+
+    Color densityColor(int count) const;
+    void uploadDirtyCells();
+    void rebuildCache();
+};
\ No newline at end of file
@@ -0,0 +1,66 @@
+// net_protocol.hpp
+
+#pragma once
+#include "asteroid.hpp"
+#include <vector>
+#include <raylib.h>
+
+// Messages between the headless simulation server and its render-only clients.
+// A client says Hello with its viewport, the server answers Welcome with the world
+// size, the player position its camera starts from and the asteroid count of every
+// grid cell for the minimap, then the client sends its
+// Input every frame and receives one Snapshot per server tick. A snapshot only carries the asteroids that entered or left the
+// client's view; asteroids never move and their rotation is integrated on the client.
+namespace NetProtocol
+{
+    const int DEFAULT_PORT = 5814;
+
+    enum class MessageType : unsigned char
+    {
+        Invalid,
+        Hello,
+        Welcome,
+        Input,
+        Snapshot
+    };
+
+    struct ReplicatedAsteroid
+    {
+        unsigned int id;
+        Asteroid asteroid;
+    };
+
+    struct Snapshot
+    {
+        unsigned int tick = 0;
+        Vector2 playerPosition = { 0, 0 };
+        float playerRotation = 0.0f;
+
+        // State of the server's camera for this client after the tick. Only sent after the
+        // client missed ticks, otherwise the client moves its own camera the same way
+        bool hasCamera = false;
+        Vector2 cameraPosition = { 0, 0 };
+        Rectangle cameraFrame = { 0, 0, 0, 0 };
+
+        std::vector<ReplicatedAsteroid> entered;    // Increasing id order
+        std::vector<unsigned int> left;             // Increasing id order
+    };
+
+    MessageType getType(const std::vector<unsigned char>& message);
+
+    void writeHello(std::vector<unsigned char>& message, Vector2 viewportSize);
+    bool readHello(const std::vector<unsigned char>& message, Vector2& viewportSize);
+
+    // Cell counts are in grid cell index order, asteroids never change cells so they are sent once
+    void writeWelcome(std::vector<unsigned char>& message, Vector2 worldSize, Vector2 playerPosition,
+                      const std::vector<int>& cellCounts);
+    bool readWelcome(const std::vector<unsigned char>& message, Vector2& worldSize, Vector2& playerPosition,
+                     std::vector<int>& cellCounts);
+
+    void writeInput(std::vector<unsigned char>& message, unsigned char input);
+    bool readInput(const std::vector<unsigned char>& message, unsigned char& input);
+
+    // Ids are delta coded, asteroid positions are quantized to 16 bits per axis of the world
+    void writeSnapshot(std::vector<unsigned char>& message, const Snapshot& snapshot, Vector2 worldSize);
+    bool readSnapshot(const std::vector<unsigned char>& message, Snapshot& snapshot, Vector2 worldSize);
+};
\ No newline at end of file
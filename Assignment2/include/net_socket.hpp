@@ -0,0 +1,64 @@
+// net_socket.hpp
+
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Minimal TCP socket for the local simulation server and its clients. Messages are
+// framed with a 4-byte length so a stream can be split back into whole messages.
+// Sockets never block: outgoing messages are queued and written as the OS takes them.
+// Does not include the platform socket headers, they clash with raylib on Windows.
+class TcpSocket
+{
+public:
+    TcpSocket() = default;
+    ~TcpSocket();
+
+    TcpSocket(const TcpSocket&) = delete;
+    TcpSocket& operator=(const TcpSocket&) = delete;
+    TcpSocket(TcpSocket&& other) noexcept;
+    TcpSocket& operator=(TcpSocket&& other) noexcept;
+
+    // Initialize the socket library once per process (Winsock)
+    static bool startup();
+    static void cleanup();
+
+    bool listen(int port);
+    bool connect(const std::string& host, int port);
+
+    // Accept one pending connection without blocking, false if there is none
+    bool accept(TcpSocket& client);
+
+    // Queue one message and write as much of the queue as the OS takes without blocking.
+    // False if the connection failed, or was closed because MAX_SEND_BACKLOG bytes are unsent
+    bool sendMessage(const std::vector<unsigned char>& message);
+
+    // Write queued bytes without blocking, false if the connection failed
+    bool flush();
+
+    // Bytes queued but not yet taken by the OS
+    size_t getPendingBytes() const { return m_sendBuffer.size(); }
+
+    // Take the next complete message without blocking, false if none has fully arrived
+    bool receiveMessage(std::vector<unsigned char>& message);
+
+    void close();
+    bool isOpen() const { return m_handle != INVALID; }
+
+    uint64_t getBytesSent() const { return m_bytesSent; }
+    uint64_t getBytesReceived() const { return m_bytesReceived; }
+
+private:
+    static const intptr_t INVALID = -1;
+    static const uint32_t MAX_MESSAGE_SIZE = 16 * 1024 * 1024;
+    static const size_t MAX_SEND_BACKLOG = 1024 * 1024;
+
+    intptr_t m_handle = INVALID;
+    std::vector<unsigned char> m_receiveBuffer;     // Bytes of incomplete messages
+    std::vector<unsigned char> m_sendBuffer;        // Queued bytes the OS has not taken yet
+    uint64_t m_bytesSent = 0;
+    uint64_t m_bytesReceived = 0;
+
+    bool setNonBlocking();
+};
\ No newline at end of file
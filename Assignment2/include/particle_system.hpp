@@ -0,0 +1,59 @@
+// particle_system.hpp
+
+#pragma once
+#include <vector>
+#include <raylib.h>
+
+// Fixed-capacity particle pool for effects. Particles live in structure of arrays
+// storage allocated once, the live ones packed at the front, so an update is a
+// 4-wide pass over the live range followed by swap-removal of the expired ones.
+// Above three quarters of the limit emitters get a shrinking share of what they
+// ask for, and a pool at its limit drops new particles, so the cost per frame is bounded.
+class ParticleSystem
+{
+public:
+    void initialize(int capacity);
+
+    // Emit count particles at position moving with velocity plus a random spread (world units per second)
+    void emit(Vector2 position, Vector2 velocity, float spread, int count,
+              Color color, float lifetime, float size);
+
+    void update(float deltaTime);
+
+    // Cap the pool below its capacity, live particles above the cap expire normally
+    void setLimit(int limit);
+
+    int getCount() const { return m_count; }
+    int getCapacity() const { return m_capacity; }
+    int getLimit() const { return m_limit; }
+
+    // Particles not emitted because of the cap since the start
+    long long getDroppedCount() const { return m_dropped; }
+
+    float getX(int i) const { return m_positionX[i]; }
+    float getY(int i) const { return m_positionY[i]; }
+    float getSize(int i) const { return m_size[i]; }
+
+    // Color faded by the remaining lifetime
+    Color getColor(int i) const;
+
+private:
+    static constexpr float DRAG = 1.5f;     // Fraction of the velocity lost per second
+
+    int m_capacity = 0;
+    int m_limit = 0;                        // Emitters fill the pool up to here
+    int m_count = 0;
+    long long m_dropped = 0;
+
+    std::vector<float> m_positionX;
+    std::vector<float> m_positionY;
+    std::vector<float> m_velocityX;
+    std::vector<float> m_velocityY;
+    std::vector<float> m_life;              // Seconds left
+    std::vector<float> m_inverseLifetime;
+    std::vector<float> m_size;
+    std::vector<Color> m_colors;
+
+    void integrate(float deltaTime);
+    void removeExpired();
+};
\ No newline at end of file
@@ -11,11 +11,18 @@ public:
     void update();
     
     void applyThrust();
-    void rotateLeft();
-    void rotateRight();
+    void rotateLeft(float deltaTime);
+    void rotateRight(float deltaTime);
+
+    // Take the state simulated elsewhere (a remote server)
+    void setState(Vector2 position, float rotation) { m_position = position; m_rotation = rotation; }
     
     Vector2 getPosition() const { return m_position; }
+    Vector2 getVelocity() const { return m_velocity; }
     float getRotation() const { return m_rotation; }
+
+    // True while the player is pushed against the edge of the area it can move in
+    bool isAtBoundary() const;
     
 private:
     Vector2 m_position = {0, 0};
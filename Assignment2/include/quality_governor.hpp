@@ -0,0 +1,68 @@
+// quality_governor.hpp
+
+#pragma once
+
+// Stages of a frame whose CPU time the governor measures
+enum class FrameStage
+{
+    Simulation,     // Input, player, asteroids, effects
+    Culling,        // Grid traversal and render commands
+    Render,         // Batch building and draw submission
+    Count
+};
+
+// Detail that can be shed under load, from background to foreground
+struct QualitySettings
+{
+    float starDensity;      // Fraction of the stars rasterized into the star tiles
+    float lodThreshold;     // Asteroids with a smaller screen half size (pixels) lose half their outline
+    float particleLimit;    // Fraction of the particle pool emitters may fill
+    bool detailedOverlay;   // Grid and camera lines under the debug text
+};
+
+// Keeps the CPU time of a frame within a budget by stepping through quality levels.
+// Stage times are smoothed over a few frames; the level goes down after the budget
+// was exceeded for a run of frames and only comes back up after a much longer run
+// well under it, so a level change does not flip back on the next frame.
+class QualityGovernor
+{
+public:
+    static constexpr double DEFAULT_BUDGET_MS = 12.0;    // Leaves room for the driver and the swap in a 60 Hz frame
+
+    // A budget of 0 keeps the full quality
+    void initialize(double budgetMilliseconds);
+
+    // Start timing a frame, every stage runs from the end of the previous one
+    void beginFrame();
+    void endStage(FrameStage stage);
+
+    // Evaluate the finished frame, true if the level changed
+    bool endFrame();
+
+    bool isEnabled() const { return m_budget > 0.0; }
+    int getLevel() const { return m_level; }
+    static int getLevelCount();
+    const QualitySettings& getSettings() const;
+
+    // Smoothed milliseconds
+    double getFrameTime() const;
+    double getStageTime(FrameStage stage) const { return m_stageTimes[(int)stage] * 1000.0; }
+    double getBudget() const { return m_budget * 1000.0; }
+
+private:
+    static constexpr double SMOOTHING = 0.1;        // Weight of the newest frame
+    static constexpr double RECOVER_RATIO = 0.6;    // Fraction of the budget a frame must stay under to raise the level
+    static const int DEGRADE_FRAMES = 15;
+    static const int RECOVER_FRAMES = 180;
+
+    double m_budget = 0.0;                          // Seconds
+    int m_level = 0;
+    int m_overBudgetFrames = 0;
+    int m_underBudgetFrames = 0;
+
+    double m_stageStart = 0.0;
+    double m_frameStages[(int)FrameStage::Count] = {};
+    double m_stageTimes[(int)FrameStage::Count] = {};  // Smoothed seconds
+
+    void changeLevel(int level, const char* reason);
+};
\ No newline at end of file
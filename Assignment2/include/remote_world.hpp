@@ -0,0 +1,67 @@
+// remote_world.hpp
+
+#pragma once
+#include "asteroid.hpp"
+#include "net_protocol.hpp"
+#include "net_socket.hpp"
+#include <string>
+#include <vector>
+#include <raylib.h>
+
+// Client side of the simulation server: holds the asteroids the server reported for
+// this client's view and the player state, updated from the snapshot deltas.
+class RemoteWorld
+{
+public:
+    // Connect, send Hello and wait for the Welcome (blocks for up to a few seconds)
+    bool connect(const std::string& host, int port, Vector2 viewportSize);
+    void disconnect();
+    bool isConnected() const { return m_socket.isOpen(); }
+
+    void sendInput(unsigned char input);
+
+    // Apply the next snapshot that has arrived, false if there is none.
+    // Each snapshot is one server tick, so per tick state (the camera) is updated per call.
+    // After the server skipped ticks for this client the snapshot carries the camera state instead
+    bool applyNextSnapshot();
+
+    // Camera state of the last snapshot, if it had one
+    bool hasCameraState() const { return m_snapshot.hasCamera; }
+    Vector2 getCameraPosition() const { return m_snapshot.cameraPosition; }
+    Rectangle getCameraFrame() const { return m_snapshot.cameraFrame; }
+
+    Vector2 getWorldSize() const { return m_worldSize; }
+
+    // Asteroid count of every grid cell of the server's world, from the Welcome
+    const std::vector<int>& getCellCounts() const { return m_cellCounts; }
+    Vector2 getPlayerPosition() const { return m_playerPosition; }
+    float getPlayerRotation() const { return m_playerRotation; }
+    unsigned int getTick() const { return m_tick; }
+
+    // Asteroids in the view, in increasing id order
+    const std::vector<Asteroid>& getAsteroids() const { return m_asteroids; }
+    const std::vector<unsigned int>& getAsteroidIds() const { return m_ids; }
+
+    uint64_t getBytesReceived() const { return m_socket.getBytesReceived(); }
+    int getSnapshotCount() const { return m_snapshotCount; }
+
+private:
+    TcpSocket m_socket;
+    Vector2 m_worldSize = { 0, 0 };
+    std::vector<int> m_cellCounts;
+    Vector2 m_playerPosition = { 0, 0 };
+    float m_playerRotation = 0.0f;
+    unsigned int m_tick = 0;
+    int m_snapshotCount = 0;
+
+    // Parallel arrays sorted by id
+    std::vector<unsigned int> m_ids;
+    std::vector<Asteroid> m_asteroids;
+
+    std::vector<unsigned char> m_message;
+    NetProtocol::Snapshot m_snapshot;
+    std::vector<unsigned int> m_mergedIds;
+    std::vector<Asteroid> m_mergedAsteroids;
+
+    void applySnapshot(const NetProtocol::Snapshot& snapshot);
+};
\ No newline at end of file
@@ -0,0 +1,133 @@
+// render_batch.hpp
+
+#pragma once
+#include "render_command.hpp"
+#include "game_camera.hpp"
+#include "sprite_atlas.hpp"
+#include "asteroid_shapes.hpp"
+#include "particle_system.hpp"
+#include <vector>
+#include <cstddef>
+#include <raylib.h>
+
+// Converts the asteroid commands of a frame to screen-space polygons in one pass,
+// scaling and rotating the shared shape templates, so no trigonometry is left for the
+// draw calls. Every primitive is textured from the sprite atlas, so a pass binds one
+// texture however many sprites it draws.
+// Each primitive gets a depth from its layer: opaque primitives are drawn front to back
+// with depth writes so hidden pixels are rejected, translucent ones back to front after them.
+// Opaque polygons of one layer are spread over the lower part of the layer's depth range,
+// so overlapping asteroids of the same layer also hide each other.
+class RenderBatch
+{
+public:
+    static const int MAX_LAYER = 31;
+
+    // Gather every command except the player and transform it for the given camera
+    void build(const RenderCommandList& commands, const GameCamera& camera, const SpriteAtlas& atlas);
+
+    // Add a screen-space sprite rotated around its center (radians), cleared by build.
+    // It is drawn after the asteroids of its pass, so it should be in the top layer
+    void addSprite(Vector2 center, Vector2 size, float rotation, SpriteId sprite, Color color, int layer);
+
+    // Add the live particles inside the camera as untextured squares in one layer, cleared by build.
+    // Drawn in the translucent pass, after the asteroids and before sprites and triangles
+    void addParticles(const ParticleSystem& particles, int layer);
+
+    // Add a screen-space triangle (counter-clockwise) in the given layer, cleared by build
+    void addTriangle(Vector2 a, Vector2 b, Vector2 c, Color color, int layer);
+
+    // Submit the opaque primitives front to back and the translucent ones back to front.
+    // Depth test and depth writes are set up by the caller.
+    void drawOpaque() const;
+    void drawTranslucent() const;
+
+    // Draw every primitive in the heat color instead of its own color
+    void setHeatmap(bool enabled, Color heatColor) { m_heatmap = enabled; m_heatColor = heatColor; }
+
+    // Polygons with a smaller screen half size (pixels) are drawn from every other outline vertex, 0 disables
+    void setLodThreshold(float pixels) { m_lodThreshold = pixels; }
+
+    // Depth of a layer for rlVertex3f, higher layers are nearer
+    static float layerDepth(int layer);
+
+    int getPolygonCount() const { return m_polygonCount; }
+    int getReducedPolygonCount() const { return m_reducedPolygonCount; }
+    int getParticleCount() const { return (int)m_particleX.size(); }
+
+    // Total screen area of all submitted primitives in pixels, every overlap counted.
+    // This is before the depth test, the pixels it rejects are only visible in the heatmap
+    float getCoveredArea() const { return m_coveredArea; }
+
+private:
+    static const int VERTEX_COUNT = AsteroidShapes::VERTEX_COUNT;
+    static constexpr float LAYER_BIAS_RANGE = 0.9f;    // Part of a layer's depth range used to order its polygons
+
+    struct Sprite
+    {
+        Vector2 corners[4];     // Top-left, bottom-left, bottom-right, top-right
+        Rectangle region;
+        Color color;
+        float depth;
+        bool opaque;
+    };
+
+    struct Triangle
+    {
+        Vector2 points[3];
+        Color color;
+        float depth;
+    };
+
+    int m_polygonCount = 0;
+    int m_reducedPolygonCount = 0;      // Below the LOD threshold
+    float m_lodThreshold = 0.0f;
+    float m_coveredArea = 0.0f;
+    bool m_heatmap = false;
+    Color m_heatColor = { 0, 0, 0, 0 };
+    const SpriteAtlas* m_atlas = nullptr;
+    Texture2D m_texture = {};
+    Rectangle m_cameraFrame = { 0, 0, 0, 0 };
+    Vector2 m_scale = { 1, 1 };         // World to screen of the last build
+    Vector2 m_offset = { 0, 0 };
+
+    // Gathered per asteroid, structure of arrays so the vertex pass can run 4 wide
+    std::vector<float> m_centerX;
+    std::vector<float> m_centerY;
+    std::vector<float> m_halfWidth;
+    std::vector<float> m_halfHeight;
+    std::vector<float> m_sin;
+    std::vector<float> m_cos;
+    std::vector<float> m_depth;
+    std::vector<Color> m_colors;
+    std::vector<Rectangle> m_regions;           // Normalized atlas coordinates
+    std::vector<unsigned char> m_shapes;
+
+    // Screen-space center and outline of each polygon
+    std::vector<float> m_screenX;
+    std::vector<float> m_screenY;
+    std::vector<float> m_vertexX[VERTEX_COUNT];
+    std::vector<float> m_vertexY[VERTEX_COUNT];
+
+    // Polygons are gathered back to front (commands are sorted by layer)
+    std::vector<int> m_opaquePolygons;          // Front to back
+    std::vector<int> m_translucentPolygons;     // Back to front
+
+    // Screen-space particle squares
+    std::vector<float> m_particleX;
+    std::vector<float> m_particleY;
+    std::vector<float> m_particleHalfSize;
+    std::vector<Color> m_particleColors;
+    float m_particleDepth = 0.0f;
+
+    std::vector<Sprite> m_sprites;
+    std::vector<Triangle> m_triangles;
+
+    void resize(size_t paddedCount);
+    void transformVertices(size_t begin, size_t end, Vector2 scale, Vector2 offset);
+    void drawPolygons(const std::vector<int>& polygons) const;
+    void drawParticles() const;
+    void drawSprites(bool opaque) const;
+    void drawTriangles(bool opaque) const;
+    Color outputColor(Color color) const { return m_heatmap ? m_heatColor : color; }
+};
\ No newline at end of file
@@ -1,11 +1,12 @@
 // render_command.hpp
 
 #pragma once
+#include "sprite_id.hpp"
+#include "memory_tracker.hpp"
 #include <raylib.h>
 
 enum class RenderCommandType
 {
-    Star,
     Asteroid,
     Player
 };
@@ -18,4 +19,9 @@ struct RenderCommand
     float rotation;
     Color color;
     int layer;
-};
\ No newline at end of file
+    SpriteId sprite;            // Atlas region the shape is textured with
+    unsigned char shapeId;      // Asteroid outline template
+};
+
+// Render command queue of one view
+using RenderCommandList = TrackedVector<RenderCommand, MemorySubsystem::RenderCommands>;
\ No newline at end of file
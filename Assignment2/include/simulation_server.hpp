@@ -0,0 +1,69 @@
+// simulation_server.hpp
+
+#pragma once
+#include "grid.hpp"
+#include "player.hpp"
+#include "game_camera.hpp"
+#include "net_protocol.hpp"
+#include "net_socket.hpp"
+#include <vector>
+#include <raylib.h>
+
+// Headless authoritative simulation of the grid and the player at a fixed tick rate.
+// Clients connect over TCP and get a snapshot per tick of only what their own camera
+// sees: all clients are culled in one traversal of the grid, and a snapshot carries
+// the asteroids that entered or left the view since the previous one. The player is
+// steered by the combined input of the connected clients.
+// Sends never block the tick: a client that has not taken its previous snapshot skips
+// ticks and gets their changes in one later snapshot, and is dropped if it stays stalled.
+class SimulationServer
+{
+public:
+    // screenWidth/screenHeight are the window size the player movement is clamped for
+    bool initialize(int port, int screenWidth, int screenHeight);
+    void shutdown();
+
+    // Run the given number of ticks in real time, or until the process ends with 0
+    void run(int tickCount);
+
+    void tick();
+
+private:
+    static const int REPORT_INTERVAL = 300;     // Ticks between statistics lines
+    static const int MAX_STALLED_TICKS = 180;   // A client that takes no data for this long is dropped
+
+    struct Client
+    {
+        TcpSocket socket;
+        bool ready = false;                     // Hello received
+        GameCamera camera;
+        unsigned char input = 0;
+        std::vector<unsigned int> knownIds;     // Asteroids the client has, increasing
+        int stalledTicks = 0;                   // Consecutive ticks skipped with unsent data
+        bool resync = false;                    // Ticks were skipped, send the camera state
+        uint64_t snapshotBytes = 0;
+        int snapshots = 0;
+    };
+
+    TcpSocket m_listener;
+    std::vector<Client> m_clients;
+    WorldGrid m_grid;
+    Player m_player;
+    Vector2 m_worldSize = { 0, 0 };
+    std::vector<int> m_cellCounts;              // Asteroids per cell, sent in every Welcome
+    unsigned int m_tick = 0;
+
+    std::vector<Rectangle> m_frusta;
+    std::vector<int> m_frustumClients;
+    std::vector<std::vector<unsigned int>> m_visibleIds;
+    NetProtocol::Snapshot m_snapshot;
+    std::vector<unsigned char> m_message;
+
+    double m_workSeconds = 0.0;     // Simulation and encoding time since the last report
+
+    void acceptClients();
+    void receiveMessages(Client& client);
+    void simulate();
+    void sendSnapshots();
+    void report();
+};
\ No newline at end of file
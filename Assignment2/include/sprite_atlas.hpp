@@ -0,0 +1,62 @@
+// sprite_atlas.hpp
+
+#pragma once
+#include "sprite_id.hpp"
+#include <future>
+#include <string>
+#include <vector>
+#include <raylib.h>
+
+// All sprites packed into one texture, so every textured and untextured quad of a
+// frame is drawn with a single texture bind. The image files are decoded and
+// downscaled on a worker thread; the main thread packs and uploads them once the
+// worker is done. Until then every region maps to raylib's white shapes texel.
+class SpriteAtlas
+{
+public:
+    // Start decoding the sprite images in the background
+    void startLoading();
+    void shutdown();
+
+    // Pack and upload the atlas once the images are decoded, call once per frame
+    void update();
+
+    bool isReady() const { return m_ready; }
+
+    Texture2D getTexture() const;
+
+    // Normalized texture coordinates of a sprite
+    Rectangle getRegion(SpriteId sprite) const;
+
+    // Aspect ratio (width / height) of a sprite's source image
+    float getAspectRatio(SpriteId sprite) const;
+
+    // False if the sprite has transparent texels, it then has to be drawn in the translucent pass
+    bool isOpaque(SpriteId sprite) const;
+
+private:
+    static const int MAX_SPRITE_SIZE = 128;     // Larger images are downscaled when loading
+    static const int PADDING = 2;               // Empty texels around each sprite against filter bleeding
+
+    struct LoadedImage
+    {
+        Image image = {};
+        bool opaque = true;
+    };
+
+    struct Region
+    {
+        Rectangle uv = { 0, 0, 0, 0 };
+        float aspectRatio = 1.0f;
+        bool opaque = true;
+    };
+
+    std::future<std::vector<LoadedImage>> m_loading;
+    Texture2D m_texture = {};
+    Region m_regions[(int)SpriteId::Count];
+    bool m_ready = false;
+    double m_loadStartTime = 0.0;
+
+    static std::vector<LoadedImage> loadImages();
+    void pack(std::vector<LoadedImage>& images);
+};
\ No newline at end of file
@@ -0,0 +1,12 @@
+// sprite_id.hpp
+
+#pragma once
+
+// Sprites packed into the SpriteAtlas, also named by plain data like render commands
+enum class SpriteId
+{
+    White,      // Untextured shapes sample this texel
+    Player,
+    Face,
+    Count
+};
\ No newline at end of file
@@ -1,19 +1,44 @@
 // starfield.hpp
 
 #pragma once
-#include "render_command.hpp"
 #include "game_camera.hpp"
+#include "memory_tracker.hpp"
 #include <vector>
+#include <raylib.h>
 
+// Stars never move in world space, so the star layer is rasterized once into
+// world-space tiles cached as render textures. Only tiles that become visible
+// are rasterized, and a frame composites the visible tiles as a few quads.
 class Starfield
 {
 public:
-    void initialize(int worldWidth, int worldHeight);
-    void addRenderCommands(std::vector<RenderCommand>& commands, const GameCamera& camera);
-    
+    // rasterScale is the number of texels per world unit in the cached tiles
+    void initialize(int worldWidth, int worldHeight, float rasterScale);
+    void shutdown();
+
+    // Rasterize the tiles that became visible in any of the frusta
+    // (must be called outside of scissor mode, tiles are drawn into their own framebuffer)
+    void updateTiles(const std::vector<Rectangle>& frusta);
+
+    // Draw the cached tiles covering the camera frustum
+    void render(const GameCamera& camera) const;
+
+    // Indices of the tiles overlapping a frustum
+    void getVisibleTiles(const Rectangle& frustum, std::vector<int>& tiles) const;
+
+    // Rasterize only this fraction of the stars of each tile, cached tiles are rasterized again
+    void setDensity(float density);
+
+    int getCachedTileCount() const { return m_cachedTileCount; }
+
+    // Bytes of the star list and the tile ranges, without the capacity slack
+    size_t getUsedBytes() const { return MemoryTracker::usedBytes(m_stars) + MemoryTracker::usedBytes(m_tileFirstStar); }
+
 private:
     static const int STAR_COUNT = 1000;
-    
+    static const int TILE_SIZE = 1024;          // Tile size in world units
+    static const int MAX_CACHED_TILES = 32;     // Least recently used tiles beyond this are released
+
     struct Star
     {
         Vector2 position;
@@ -21,8 +46,30 @@ private:
         Color color;
         float parallaxFactor;
     };
-    
-    std::vector<Star> m_stars;
+
+    struct Tile
+    {
+        RenderTexture2D texture = {};
+        bool cached = false;
+        unsigned int lastUsedFrame = 0;
+    };
+
+    TrackedVector<Star, MemorySubsystem::Stars> m_stars;        // Sorted by tile
+    TrackedVector<int, MemorySubsystem::Stars> m_tileFirstStar; // Stars of tile i are [m_tileFirstStar[i], m_tileFirstStar[i + 1])
+    TrackedUsage<MemorySubsystem::Stars> m_usage;
+    std::vector<Tile> m_tiles;
+    std::vector<int> m_visibleTiles;
+
     int m_screenWidth = 0;
     int m_screenHeight = 0;
+    int m_tilesX = 0;
+    int m_tilesY = 0;
+    float m_rasterScale = 1.0f;
+    float m_density = 1.0f;
+    int m_cachedTileCount = 0;
+    unsigned int m_frame = 0;
+
+    void getTileRange(const Rectangle& frustum, int& startX, int& endX, int& startY, int& endY) const;
+    void rasterizeTile(int index);
+    void releaseLeastRecentlyUsedTile();
 };
\ No newline at end of file
@@ -2,36 +2,86 @@
 
 #include "application.hpp"
 #include "math_utils.hpp"
+#include "memory_tracker.hpp"
 #include <raylib.h>
+#include <rlgl.h>
 #include <iostream>
 #include <algorithm>
+#include <cstdlib>
 
 bool Application::initialize(int width, int height)
 {
     this->m_width = width;
     this->m_height = height;
 
-    m_worldSize = { 10000, 10000 };
+    // Recorded and replayed runs generate the same world
+    if (m_input.isDeterministic()) SetRandomSeed(m_input.getSeed());
+
+    // Decode the sprites in the background while the world is generated
+    m_atlas.startLoading();
+
+    m_worldSize = { (float)(WORLD_CELL_COUNT * WORLD_CELL_SIZE), (float)(WORLD_CELL_COUNT * WORLD_CELL_SIZE) };
+    Vector2 playerPosition = { m_worldSize.x / 2.0f, m_worldSize.y / 2.0f };
+
+    // A client's view is the server's main camera with the window size
+    if (!m_serverAddress.empty())
+    {
+        size_t colon = m_serverAddress.rfind(':');
+        std::string host = m_serverAddress.substr(0, colon);
+        int port = colon == std::string::npos ? NetProtocol::DEFAULT_PORT : std::atoi(m_serverAddress.c_str() + colon + 1);
+
+        if (!TcpSocket::startup()) return false;
+        if (!m_remote.connect(host, port, { (float)m_width, (float)m_height })) return false;
+
+        m_worldSize = m_remote.getWorldSize();
+        playerPosition = m_remote.getPlayerPosition();
+    }
 
     // Initialize World Grid (10x10 sectionsEach 1000x1000 pixel)
-    m_grid.initialize(10, 10, 1000, 1000, m_width, m_height);
+    if (!m_grid.initialize(WORLD_CELL_COUNT, WORLD_CELL_COUNT, WORLD_CELL_SIZE, WORLD_CELL_SIZE, m_width, m_height)) return false;
 
-    // Generate 6000 asteroids
-    m_totalAsteroids = 6000;
-    m_grid.generateAsteroids(m_totalAsteroids);
+    // Generate 6000 asteroids, a client's grid stays empty
+    if (m_serverAddress.empty())
+    {
+        m_totalAsteroids = 6000;
+        m_grid.generateAsteroids(m_totalAsteroids);
+    }
 
     // Initialize the player's position at the center of the world
-    m_player.initialize({ m_worldSize.x / 2.0f, m_worldSize.y / 2.0f });
+    m_player.initialize(playerPosition);
 
-    // Initialize camera
+    // Initialize the main camera
     Vector2 viewportSize = { (float)m_width, (float)m_height };
     Vector2 screenSize = { (float)m_width, (float)m_height };
-    m_camera.initialize(m_player.getPosition(), viewportSize, m_worldSize, screenSize);
+    m_views.resize(1);
+    m_views[0].camera.initialize(m_player.getPosition(), viewportSize, m_worldSize, screenSize);
+
+    m_player.setViewParameter(m_worldSize, m_views[0].camera.getCameraFrame());
+
+    // Initialize starfield, tiles are rasterized at the main camera's scale
+    Rectangle cameraFrame = m_views[0].camera.getCameraFrame();
+    m_starfield.initialize((int)m_worldSize.x, (int)m_worldSize.y, cameraFrame.width / viewportSize.x); // Enter world size
+
+    m_particles.initialize(MAX_PARTICLES);
+
+    // Recorded and replayed runs compare frame times, so they keep the same detail throughout
+    m_governor.initialize(m_input.isDeterministic() ? 0.0 : m_frameBudget);
+    applyQualitySettings();
+
+    // Initialize minimap in the top right corner of the screen
+    float miniMapSize = m_width / 10.0f;
+    m_minimap.initialize(m_grid, { m_width - miniMapSize, 0, miniMapSize, miniMapSize });
 
-    m_player.setViewParameter(m_worldSize, m_camera.getCameraFrame());
+    // A client's grid is empty, the density comes from the server
+    if (!m_serverAddress.empty())
+    {
+        const std::vector<int>& cellCounts = m_remote.getCellCounts();
+        if ((int)cellCounts.size() == m_grid.getWidth() * m_grid.getHeight()) m_minimap.setCellCounts(cellCounts);
+        else std::cerr << "Server grid has " << cellCounts.size() << " cells, the minimap stays empty" << std::endl;
+    }
 
-    // Initialize starfield
-    m_starfield.initialize((int)m_worldSize.x, (int)m_worldSize.y); // Enter world size
+    // The render loop takes sin/cos from a lookup table, check it against the C library once
+    std::cout << "Sin/cos table max error: " << MathUtils::fastSinCosMaxError() << std::endl;
 
     std::cout << "Application initialized successfully" << std::endl;
     return true;
@@ -39,165 +89,375 @@ bool Application::initialize(int width, int height)
 
 void Application::shutdown()
 {
+    // Footprint at exit, before anything is released
+    MemoryTracker::report(std::cout);
+
     // Clean up resources
+    m_input.finish();
+    m_minimap.shutdown();
+    m_starfield.shutdown();
+    m_atlas.shutdown();
+
+    if (!m_serverAddress.empty())
+    {
+        m_remote.disconnect();
+        TcpSocket::cleanup();
+    }
+}
+
+bool Application::recordInput(const std::string& path)
+{
+    return m_input.startRecording(path);
+}
+
+bool Application::replayInput(const std::string& path)
+{
+    return m_input.startPlayback(path);
 }
 
 void Application::update()
 {
+    m_frameStartTime = GetTime();
+    m_governor.beginFrame();
+
     processInput();
 
-    // Update players
-    m_player.update();
+    if (!m_serverAddress.empty())
+    {
+        // One camera update per server tick, the server culls with the same camera
+        while (m_remote.applyNextSnapshot())
+        {
+            m_player.setState(m_remote.getPlayerPosition(), m_remote.getPlayerRotation());
+            updateCamera();
+
+            // The server moved the camera through ticks this client missed, take its state
+            if (m_remote.hasCameraState())
+            {
+                m_views[0].camera.setState(m_remote.getCameraPosition(), m_remote.getCameraFrame());
+            }
+        }
+    }
+    else
+    {
+        // Update players
+        m_player.update();
+
+        // Update camera to follow players
+        updateCamera();
+
+        // Update asteroid rotation
+        m_grid.updateAsteroids();
+    }
 
-    // Update camera to follow players
-    updateCamera();
+    updateEffects(m_input.getTimestep());
 
-    // Update asteroid rotation
-    m_grid.updateAsteroids();
+    // Refresh minimap cells whose asteroid count changed
+    m_minimap.update(m_grid);
+
+    // Upload the sprite atlas once its images are decoded
+    m_atlas.update();
+    m_governor.endStage(FrameStage::Simulation);
 
     // Collect rendering commands
     collectRenderCommands();
+    m_governor.endStage(FrameStage::Culling);
 }
 
 void Application::processInput()
 {
-    // Player control
-    if (IsKeyDown(KEY_W)) m_player.applyThrust();
-    if (IsKeyDown(KEY_A)) m_player.rotateLeft();
-    if (IsKeyDown(KEY_D)) m_player.rotateRight();
+    // Live keys, or the recorded keys of this tick when replaying
+    unsigned char input = m_input.nextTick();
+    float deltaTime = m_input.getTimestep();
+
+    // Exhaust also for a remote player, it is only an effect
+    if (input & INPUT_THRUST) emitThrust();
+
+    // Player control, the server moves the player when connected to one
+    if (!m_serverAddress.empty())
+    {
+        m_remote.sendInput(input & INPUT_PLAYER_CONTROLS);
+    }
+    else
+    {
+        if (input & INPUT_THRUST) m_player.applyThrust();
+        if (input & INPUT_ROTATE_LEFT) m_player.rotateLeft(deltaTime);
+        if (input & INPUT_ROTATE_RIGHT) m_player.rotateRight(deltaTime);
+    }
 
     // Switch debugging display
-    if (IsKeyPressed(KEY_F1)) m_showDebug = !m_showDebug;
+    if (input & INPUT_TOGGLE_DEBUG) m_showDebug = !m_showDebug;
+
+    // Switch the spectator view
+    if (input & INPUT_TOGGLE_SPECTATOR) toggleSpectatorView();
+
+    // Switch the overdraw heatmap
+    if (input & INPUT_TOGGLE_OVERDRAW) m_showOverdraw = !m_showOverdraw;
 }
 
-void Application::updateCamera()
+void Application::emitThrust()
 {
-    m_camera.update(m_player.getPosition());
+    // Exhaust behind the tail, thrown backwards on top of the player's own velocity
+    float sine, cosine;
+    MathUtils::fastSinCos(m_player.getRotation(), sine, cosine);
+    Vector2 position = m_player.getPosition();
+    Vector2 velocity = m_player.getVelocity();
+    Vector2 tail = { position.x - cosine * 25.0f, position.y - sine * 25.0f };
+    Vector2 exhaust = { velocity.x * 60.0f - cosine * 250.0f, velocity.y * 60.0f - sine * 250.0f };
+
+    Color flame = { 255, 160, 40, 220 };
+    m_particles.emit(tail, exhaust, 60.0f, 6, flame, 0.5f, 6.0f);
 }
 
-void Application::collectRenderCommands()
+void Application::updateEffects(float deltaTime)
 {
-    m_renderCommands.clear();
-    m_visibleAsteroids = 0;
+    // A burst of sparks when the player runs into the edge
+    bool atBoundary = m_player.isAtBoundary();
+    if (atBoundary && !m_playerAtBoundary)
+    {
+        Color spark = { 255, 240, 180, 255 };
+        m_particles.emit(m_player.getPosition(), { 0, 0 }, 300.0f, 80, spark, 0.8f, 4.0f);
+    }
+    m_playerAtBoundary = atBoundary;
 
-    // Add starry sky to rendering queue (background layer)
-    m_starfield.addRenderCommands(m_renderCommands, m_camera);
+    m_particles.update(deltaTime);
+}
+
+void Application::applyQualitySettings()
+{
+    const QualitySettings& settings = m_governor.getSettings();
+    m_starfield.setDensity(settings.starDensity);
+    m_renderBatch.setLodThreshold(settings.lodThreshold);
+    m_particles.setLimit((int)(MAX_PARTICLES * settings.particleLimit));
+}
+
+void Application::updateCamera()
+{
+    m_views[0].camera.update(m_player.getPosition());
 
-    // Obtain asteroids in the visible region
-    Rectangle frustum = m_camera.getFrustum();
-    auto visibleAsteroids = m_grid.getVisibleAsteroids(frustum);
-    m_visibleAsteroids = (int)visibleAsteroids.size();
+    // Other views keep their frame fixed on screen and center on the player
+    for (size_t i = 1; i < m_views.size(); i++)
+    {
+        m_views[i].camera.lookAt(m_player.getPosition());
+    }
+}
 
-    // Add asteroid to rendering queue
-    for (const auto& asteroid : visibleAsteroids)
+void Application::toggleSpectatorView()
+{
+    if (m_views.size() > 1)
     {
-        RenderCommand cmd;
-        cmd.type = RenderCommandType::Asteroid;
-        cmd.position = asteroid.position;
-        cmd.rotation = asteroid.rotation;
-        cmd.size = asteroid.size;
-        cmd.color = asteroid.color;
-        cmd.layer = asteroid.layer; // Set hierarchy based on size
+        m_views.resize(1);
+        return;
+    }
+
+    // Zoomed out view of the area around the player, in the bottom right corner of the screen
+    Vector2 viewportSize = { m_width * 3.0f, m_height * 3.0f };
+    Vector2 screenSize = { (float)m_width, (float)m_height };
+    Rectangle frame = {
+        m_width * 0.75f - 10,
+        m_height * 0.75f - 10,
+        m_width * 0.25f,
+        m_height * 0.25f
+    };
+
+    CameraView spectator;
+    spectator.camera.initialize(m_player.getPosition(), viewportSize, m_worldSize, screenSize);
+    spectator.camera.setCameraFrame(frame);
+    m_views.push_back(spectator);
+}
 
-        m_renderCommands.push_back(cmd);
+void Application::collectRenderCommands()
+{
+    // Cull the asteroids for every view in one traversal of the grid
+    m_frusta.clear();
+    for (const auto& view : m_views)
+    {
+        m_frusta.push_back(view.camera.getFrustum());
+    }
+    if (m_serverAddress.empty())
+    {
+        m_grid.getVisibleAsteroids(m_frusta, m_visiblePerView);
+    }
+    else
+    {
+        // The server culled for the main camera, other views show the same asteroids
+        m_visiblePerView.assign(m_views.size(), m_remote.getAsteroids());
+        m_totalAsteroids = (int)m_remote.getAsteroids().size();
     }
+    m_visibleAsteroids = (int)m_visiblePerView[0].size();
+
+    // Rasterize star tiles that became visible in any view
+    m_starfield.updateTiles(m_frusta);
 
-    // Add players to the rendering queue (top-level)
-    RenderCommand playerCmd;
-    playerCmd.type = RenderCommandType::Player;
-    playerCmd.position = m_player.getPosition();
-    playerCmd.rotation = m_player.getRotation();
-    playerCmd.size = { 30, 30 };
-    playerCmd.color = RED;
-    playerCmd.layer = 10; // The highest level
+    for (size_t i = 0; i < m_views.size(); i++)
+    {
+        auto& renderCommands = m_views[i].renderCommands;
+        renderCommands.clear();
 
-    m_renderCommands.push_back(playerCmd);
+        // Add asteroid to rendering queue
+        for (const auto& asteroid : m_visiblePerView[i])
+        {
+            RenderCommand cmd;
+            cmd.type = RenderCommandType::Asteroid;
+            cmd.position = asteroid.position;
+            cmd.rotation = asteroid.rotation;
+            cmd.size = asteroid.size;
+            cmd.color = asteroid.color;
+            cmd.layer = asteroid.layer; // Set hierarchy based on size
+            cmd.sprite = SpriteId::White;
+            cmd.shapeId = asteroid.shapeId;
+
+            renderCommands.push_back(cmd);
+        }
+
+        // Add players to the rendering queue (top-level)
+        RenderCommand playerCmd;
+        playerCmd.type = RenderCommandType::Player;
+        playerCmd.position = m_player.getPosition();
+        playerCmd.rotation = m_player.getRotation();
+        playerCmd.size = { 30, 30 };
+        playerCmd.color = RED;
+        playerCmd.layer = 10; // The highest level
+        playerCmd.sprite = SpriteId::Player;
+        playerCmd.shapeId = 0;
+
+        renderCommands.push_back(playerCmd);
+
+        // Sort rendering commands by hierarchy
+        std::sort(renderCommands.begin(), renderCommands.end(),
+            [](const RenderCommand& a, const RenderCommand& b) {
+                return a.layer < b.layer;
+            });
+    }
 
-    // Sort rendering commands by hierarchy
-    std::sort(m_renderCommands.begin(), m_renderCommands.end(),
-        [](const RenderCommand& a, const RenderCommand& b) {
-            return a.layer < b.layer;
-        });
+    // The queues are refilled every frame, their capacity stays at the largest frame so far
+    size_t commandBytes = 0;
+    for (const auto& view : m_views)
+    {
+        commandBytes += MemoryTracker::usedBytes(view.renderCommands);
+    }
+    m_commandUsage.set(commandBytes);
 }
 
 void Application::render()
 {
-    // Obtain camera information
-    Vector2 cameraPos = m_camera.getPosition();
-    Vector2 viewportSize = m_camera.getViewportSize();
-    Rectangle cameraFrame = m_camera.getCameraFrame();
-
-    // Calculate the conversion ratio from world coordinates to camera frame coordinates
-    float scaleX = cameraFrame.width / viewportSize.x;
-    float scaleY = cameraFrame.height / viewportSize.y;
-
-    // Execute sorted rendering commands
-    for (const auto& cmd : m_renderCommands)
-    {
-        // Convert world coordinates to screen coordinates within the camera frame
-        Vector2 screenPos = {
-            cameraFrame.x + (cmd.position.x - cameraPos.x + viewportSize.x / 2) * scaleX,
-            cameraFrame.y + (cmd.position.y - cameraPos.y + viewportSize.y / 2) * scaleY
-        };
-
-        // Adjust the size ratio according to the command type
-        Vector2 scaledSize = {
-            cmd.size.x * scaleX,
-            cmd.size.y * scaleY
-        };
-
-        switch (cmd.type)
-        {
-        case RenderCommandType::Star:
-            DrawRectanglePro(
-                Rectangle{ screenPos.x, screenPos.y, scaledSize.x, scaledSize.y },
-                { scaledSize.x / 2, scaledSize.y / 2 },
-                cmd.rotation,
-                cmd.color
-            );
-            break;
-
-        case RenderCommandType::Asteroid:
-            DrawRectanglePro(
-                Rectangle{ screenPos.x, screenPos.y, scaledSize.x, scaledSize.y },
-                { scaledSize.x / 2, scaledSize.y / 2 },
-                cmd.rotation,
-                cmd.color
-            );
-            break;
-
-        case RenderCommandType::Player:
-            // The player is always in the center of the camera frame
-            Vector2 center = {
-                cameraFrame.x + cameraFrame.width / 2,
-                cameraFrame.y + cameraFrame.height / 2
-            };
-
-            Vector2 front = {
-                center.x + cosf(cmd.rotation) * scaledSize.x,
-                center.y + sinf(cmd.rotation) * scaledSize.y
-            };
-            Vector2 left = {
-                center.x + cosf(cmd.rotation + 2.5f) * scaledSize.x,
-                center.y + sinf(cmd.rotation + 2.5f) * scaledSize.y
-            };
-            Vector2 right = {
-                center.x + cosf(cmd.rotation - 2.5f) * scaledSize.x,
-                center.y + sinf(cmd.rotation - 2.5f) * scaledSize.y
-            };
-
-            DrawTriangle(front, right, left, cmd.color);
-            break;
-        }
+    renderView(m_views[0], true);
+
+    // Secondary views are clipped to their own frame on top of the main view
+    for (size_t i = 1; i < m_views.size(); i++)
+    {
+        Rectangle frame = m_views[i].camera.getCameraFrame();
+
+        // Clearing inside the scissor rectangle also resets the depth of the main view there
+        BeginScissorMode((int)frame.x, (int)frame.y, (int)frame.width, (int)frame.height);
+        ClearBackground(BLACK);
+        renderView(m_views[i], false);
+        EndScissorMode();
+
+        DrawRectangleLinesEx(frame, 1.0f, DARKGRAY);
     }
 
+    m_minimap.render(m_views[0].camera, m_player.getPosition());
+
     // Rendering and debugging information
     if (m_showDebug)
     {
         renderDebugInfo();
-        m_grid.renderDebug(m_camera);
-        m_camera.renderDebug();
+        if (m_governor.getSettings().detailedOverlay)
+        {
+            m_grid.renderDebug(m_views[0].camera);
+            m_views[0].camera.renderDebug();
+        }
     }
+
+    // CPU time of this frame so far, excluding the wait for the next frame in EndDrawing
+    m_input.recordFrameTime(GetTime() - m_frameStartTime, GetFrameTime());
+
+    // New settings take effect from the next frame
+    m_governor.endStage(FrameStage::Render);
+    if (m_governor.endFrame()) applyQualitySettings();
+}
+
+void Application::renderView(const CameraView& view, bool isMainView)
+{
+    // Transform every asteroid to screen space in one pass
+    m_renderBatch.build(view.renderCommands, view.camera, m_atlas);
+    m_renderBatch.addParticles(m_particles, PARTICLE_LAYER);
+
+    for (const auto& cmd : view.renderCommands)
+    {
+        if (cmd.type == RenderCommandType::Player) addPlayer(cmd, view.camera, isMainView);
+    }
+
+    // The heatmap adds a constant per drawn primitive, bright areas are shaded many times
+    Color heatColor = { 40, 12, 4, 255 };
+    m_renderBatch.setHeatmap(m_showOverdraw, heatColor);
+    if (m_showOverdraw) BeginBlendMode(BLEND_ADDITIVE);
+
+    // Opaque pass: front to back with depth writes, so pixels hidden behind
+    // nearer asteroids are rejected by the depth test instead of shaded again
+    rlDrawRenderBatchActive();
+    rlEnableDepthTest();
+    m_renderBatch.drawOpaque();
+    rlDrawRenderBatchActive();
+
+    // Translucent pass: back to front, tested against the opaque depth but not writing it.
+    // The star tiles are the deepest layer, their texels behind asteroids are rejected too
+    rlDisableDepthMask();
+    if (m_showOverdraw) DrawRectangleRec(view.camera.getCameraFrame(), heatColor);
+    else m_starfield.render(view.camera);
+    m_renderBatch.drawTranslucent();
+    rlDrawRenderBatchActive();
+    rlEnableDepthMask();
+    rlDisableDepthTest();
+
+    if (m_showOverdraw) EndBlendMode();
+
+    if (isMainView)
+    {
+        // Star tiles cover the frame once, everything else adds its own area
+        Rectangle cameraFrame = view.camera.getCameraFrame();
+        float frameArea = cameraFrame.width * cameraFrame.height;
+        m_submittedCoverage = (frameArea + m_renderBatch.getCoveredArea()) / frameArea;
+        m_reducedAsteroids = m_renderBatch.getReducedPolygonCount();
+    }
+}
+
+void Application::addPlayer(const RenderCommand& cmd, const GameCamera& camera, bool isMainView)
+{
+    // Obtain camera information
+    Vector2 viewportSize = camera.getViewportSize();
+    Rectangle cameraFrame = camera.getCameraFrame();
+
+    // The player is always in the center of the main camera frame
+    Vector2 center = isMainView
+        ? Vector2{ cameraFrame.x + cameraFrame.width / 2, cameraFrame.y + cameraFrame.height / 2 }
+        : camera.worldToScreen(cmd.position);
+
+    // Adjust the size ratio to the camera frame
+    Vector2 scaledSize = {
+        cmd.size.x * cameraFrame.width / viewportSize.x,
+        cmd.size.y * cameraFrame.height / viewportSize.y
+    };
+
+    // The plane sprite points up, rotation 0 points right
+    if (m_atlas.isReady())
+    {
+        Vector2 spriteSize = { 2 * scaledSize.y * m_atlas.getAspectRatio(cmd.sprite), 2 * scaledSize.y };
+        m_renderBatch.addSprite(center, spriteSize, cmd.rotation + PI / 2, cmd.sprite, WHITE, cmd.layer);
+        return;
+    }
+
+    // Plain triangle until the atlas is loaded
+    float frontSin, frontCos, leftSin, leftCos, rightSin, rightCos;
+    MathUtils::fastSinCos(cmd.rotation, frontSin, frontCos);
+    MathUtils::fastSinCos(cmd.rotation + 2.5f, leftSin, leftCos);
+    MathUtils::fastSinCos(cmd.rotation - 2.5f, rightSin, rightCos);
+
+    Vector2 front = { center.x + frontCos * scaledSize.x, center.y + frontSin * scaledSize.y };
+    Vector2 left = { center.x + leftCos * scaledSize.x, center.y + leftSin * scaledSize.y };
+    Vector2 right = { center.x + rightCos * scaledSize.x, center.y + rightSin * scaledSize.y };
+
+    m_renderBatch.addTriangle(front, right, left, cmd.color, cmd.layer);
 }
 
 void Application::renderDebugInfo()
@@ -207,7 +467,32 @@ void Application::renderDebugInfo()
     DrawText(TextFormat("Position: (%.1f, %.1f)",
         m_player.getPosition().x,
         m_player.getPosition().y), 10, 60, 20, GRAY);
+    DrawText(TextFormat("Submitted coverage: %.2fx (F3 shows the depth-tested overdraw)", m_submittedCoverage), 10, 85, 20, GRAY);
+    DrawText(TextFormat("Particles: %d/%d (%lld dropped)",
+        m_particles.getCount(),
+        m_particles.getLimit(),
+        m_particles.getDroppedCount()), 10, 110, 20, GRAY);
+    DrawText(TextFormat("Quality: %d/%d, %.1f/%.1f ms (sim %.1f, cull %.1f, render %.1f), %d asteroids reduced",
+        m_governor.getLevel(),
+        QualityGovernor::getLevelCount() - 1,
+        m_governor.getFrameTime(),
+        m_governor.getBudget(),
+        m_governor.getStageTime(FrameStage::Simulation),
+        m_governor.getStageTime(FrameStage::Culling),
+        m_governor.getStageTime(FrameStage::Render),
+        m_reducedAsteroids), 10, 135, 20, GRAY);
+
+    for (int i = 0; i < (int)MemorySubsystem::Count; i++)
+    {
+        MemoryStats stats = MemoryTracker::getStats((MemorySubsystem)i);
+        DrawText(TextFormat("Memory %s: %.1f/%.1f KiB (peak %.1f KiB, %lld allocs)",
+            MemoryTracker::getName((MemorySubsystem)i),
+            (float)stats.usedBytes / 1024.0f,
+            (float)stats.reservedBytes / 1024.0f,
+            (float)stats.peakReservedBytes / 1024.0f,
+            stats.allocations), 10, 160 + 25 * i, 20, GRAY);
+    }
 
     // Display control prompts
-    DrawText("Controls: W - Thrust, A/D - Rotate, F1 - Toggle Debug", 10, m_height - 30, 20, GRAY);
+    DrawText("Controls: W - Thrust, A/D - Rotate, F1 - Toggle Debug, F2 - Spectator View, F3 - Overdraw", 10, m_height - 30, 20, GRAY);
 }
\ No newline at end of file
@@ -3,14 +3,15 @@
 #include "asteroid.hpp"
 
 void Asteroid::initialize(Vector2 pos, Vector2 sz, float rot,
-    float rotSpeed, Color col, int lyr)
+    float rotSpeed, Color col, int lyr, unsigned char shape)
 {
     position = pos;
     size = sz;
     rotation = rot;
     rotationSpeed = rotSpeed;
     color = col;
-    layer = lyr;
+    layer = (unsigned char)lyr;
+    shapeId = shape;
 }
 
 void Asteroid::update()
@@ -0,0 +1,67 @@
+// asteroid_shapes.cpp
+
+#include "asteroid_shapes.hpp"
+#include "math_utils.hpp"
+#include <array>
+#include <cmath>
+
+namespace
+{
+    // Larger asteroids get deeper dents
+    const float ROUGHNESS[AsteroidShapes::SIZE_CLASSES] = { 0.15f, 0.25f, 0.35f };
+
+    std::array<AsteroidShapes::Shape, AsteroidShapes::SHAPE_COUNT> generateShapes()
+    {
+        using namespace AsteroidShapes;
+
+        // Own generator, so the templates are the same in every run and do not
+        // consume values from the seeded world generation
+        unsigned int state = 5814;
+        auto nextRandom = [&state]() {
+            state = state * 1664525u + 1013904223u;
+            return (float)(state >> 8) / (float)(1u << 24);
+        };
+
+        std::array<Shape, SHAPE_COUNT> shapes = {};
+        for (int id = 0; id < SHAPE_COUNT; id++)
+        {
+            Shape& shape = shapes[id];
+            float roughness = ROUGHNESS[id / SHAPES_PER_SIZE];
+
+            // Jittered radius and angle per vertex, increasing angles keep the polygon star-shaped
+            for (int k = 0; k < VERTEX_COUNT; k++)
+            {
+                float angle = (k + (nextRandom() - 0.5f) * 0.5f) * 2.0f * PI / VERTEX_COUNT;
+                float radius = 1.0f - roughness * nextRandom();
+                shape.vertices[k] = { cosf(angle) * radius, sinf(angle) * radius };
+            }
+
+            // Fan of triangles around the center
+            shape.area = 0.0f;
+            for (int k = 0; k < VERTEX_COUNT; k++)
+            {
+                Vector2 a = shape.vertices[k];
+                Vector2 b = shape.vertices[(k + 1) % VERTEX_COUNT];
+                shape.area += (a.x * b.y - b.x * a.y) / 2;
+            }
+        }
+
+        return shapes;
+    }
+
+    const std::array<AsteroidShapes::Shape, AsteroidShapes::SHAPE_COUNT> SHAPES = generateShapes();
+}
+
+namespace AsteroidShapes
+{
+    const Shape& get(unsigned char shapeId)
+    {
+        return SHAPES[shapeId % SHAPE_COUNT];
+    }
+
+    unsigned char pick(int sizeClass)
+    {
+        int variant = MathUtils::random(0, SHAPES_PER_SIZE - 1);
+        return (unsigned char)(sizeClass * SHAPES_PER_SIZE + variant);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,289 @@
+// benchmark.cpp
+
+#include "benchmark.hpp"
+#include "grid.hpp"
+#include "starfield.hpp"
+#include "math_utils.hpp"
+#include "memory_tracker.hpp"
+#include <raylib.h>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace Benchmark
+{
+    namespace
+    {
+        const int WORLD_SIZE = 10000;
+        const int ASTEROID_COUNTS[] = { 1000, 10000, 100000, 1000000 };
+        const int CELL_SIZES[] = { 250, 500, 1000, 2000 };
+        const Vector2 VIEWPORTS[] = { { 640, 360 }, { 1280, 720 }, { 2560, 1440 } };
+        const int QUERY_COUNT = 256;
+
+        // Hardware cache miss counter of the calling thread, if the platform provides one
+        class CacheMissCounter
+        {
+        public:
+            CacheMissCounter()
+            {
+#if defined(__linux__)
+                perf_event_attr attr = {};
+                attr.type = PERF_TYPE_HARDWARE;
+                attr.size = sizeof(attr);
+                attr.config = PERF_COUNT_HW_CACHE_MISSES;
+                attr.disabled = 1;
+                attr.exclude_kernel = 1;
+                attr.exclude_hv = 1;
+                m_fd = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+#endif
+            }
+
+            ~CacheMissCounter()
+            {
+#if defined(__linux__)
+                if (m_fd >= 0) close(m_fd);
+#endif
+            }
+
+            void start()
+            {
+#if defined(__linux__)
+                if (m_fd < 0) return;
+                ioctl(m_fd, PERF_EVENT_IOC_RESET, 0);
+                ioctl(m_fd, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+            }
+
+            // Misses since start, or -1 when not available
+            long long stop()
+            {
+#if defined(__linux__)
+                if (m_fd < 0) return -1;
+                ioctl(m_fd, PERF_EVENT_IOC_DISABLE, 0);
+                long long count = 0;
+                if (read(m_fd, &count, sizeof(count)) != sizeof(count)) return -1;
+                return count;
+#else
+                return -1;
+#endif
+            }
+
+        private:
+            int m_fd = -1;
+        };
+
+        struct Result
+        {
+            std::string benchmark;
+            int asteroids;
+            int cellSize;
+            Vector2 viewport;
+            int iterations;
+            double nsPerIteration;
+            double objectsPerNs;
+            double cellsVisited;
+            long long cacheMisses;
+        };
+
+        // Measure fn() repeated for the given number of iterations
+        template <typename Fn>
+        double measureNs(int iterations, CacheMissCounter& counter, long long& cacheMisses, Fn fn)
+        {
+            counter.start();
+            auto start = std::chrono::steady_clock::now();
+            for (int i = 0; i < iterations; i++)
+            {
+                fn(i);
+            }
+            auto end = std::chrono::steady_clock::now();
+            cacheMisses = counter.stop();
+
+            return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+        }
+
+        void report(std::ofstream& file, const Result& result)
+        {
+            file << result.benchmark << "," << result.asteroids << "," << result.cellSize << ","
+                << result.viewport.x << "," << result.viewport.y << "," << result.iterations << ","
+                << result.nsPerIteration << "," << result.objectsPerNs << ","
+                << result.cellsVisited << "," << result.cacheMisses << "\n";
+
+            std::cout << result.benchmark << " asteroids=" << result.asteroids
+                << " cell=" << result.cellSize
+                << " viewport=" << result.viewport.x << "x" << result.viewport.y
+                << " ns/iter=" << result.nsPerIteration
+                << " objects/ns=" << result.objectsPerNs
+                << " cells=" << result.cellsVisited
+                << " misses=" << result.cacheMisses << std::endl;
+        }
+
+        // Random frusta inside the world, the same set for every configuration
+        std::vector<Rectangle> makeFrusta(Vector2 viewport)
+        {
+            std::vector<Rectangle> frusta(QUERY_COUNT);
+            for (auto& frustum : frusta)
+            {
+                frustum = {
+                    MathUtils::random(0.0f, WORLD_SIZE - viewport.x),
+                    MathUtils::random(0.0f, WORLD_SIZE - viewport.y),
+                    viewport.x,
+                    viewport.y
+                };
+            }
+            return frusta;
+        }
+
+        // Generation, update and visibility queries for one grid configuration
+        template <typename GridType>
+        void benchmarkGridConfig(std::ofstream& file, CacheMissCounter& counter, const std::string& name,
+                                 int count, int cells, int cellSize)
+        {
+            long long misses = 0;
+
+            // Generation (one iteration, it fills the grid used below)
+            SetRandomSeed(5814);
+            GridType grid;
+            if (!grid.initialize(cells, cells, cellSize, cellSize, cells * cellSize, cells * cellSize)) return;
+            double ns = measureNs(1, counter, misses, [&](int) {
+                grid.generateAsteroids(count);
+            });
+            report(file, { name + "_generate", count, cellSize, { 0, 0 }, 1, ns, count / ns, 0, misses });
+
+            // Footprint of the filled grid, the only one alive, so the tracked capacity is all its own
+            size_t used = grid.getUsedBytes();
+            long long reserved = MemoryTracker::getStats(MemorySubsystem::GridCells).reservedBytes;
+            std::cout << name << "_memory asteroids=" << count << " cell=" << cellSize
+                << " used=" << used << " reserved=" << reserved
+                << " slack=" << (reserved - (long long)used) * 100.0 / reserved << "%" << std::endl;
+
+            // Update of every asteroid
+            const int updates = 8;
+            ns = measureNs(updates, counter, misses, [&](int) {
+                grid.updateAsteroids();
+            });
+            report(file, { name + "_update", count, cellSize, { 0, 0 }, updates, ns / updates,
+                           (double)count * updates / ns, 0, misses });
+
+            // Visibility queries, throughput counts the asteroids tested
+            for (Vector2 viewport : VIEWPORTS)
+            {
+                SetRandomSeed(42);
+                std::vector<Rectangle> frusta = makeFrusta(viewport);
+                long long cellsVisited = 0, tested = 0;
+                size_t visible = 0;
+
+                ns = measureNs(QUERY_COUNT, counter, misses, [&](int i) {
+                    visible += grid.getVisibleAsteroids(frusta[i]).size();
+                    cellsVisited += grid.getLastQueryStats().cellsVisited;
+                    tested += grid.getLastQueryStats().asteroidsTested;
+                });
+                report(file, { name + "_visible", count, cellSize, viewport, QUERY_COUNT, ns / QUERY_COUNT,
+                               tested / ns, (double)cellsVisited / QUERY_COUNT, misses });
+            }
+        }
+
+        void benchmarkGrid(std::ofstream& file, CacheMissCounter& counter)
+        {
+            for (int count : ASTEROID_COUNTS)
+            {
+                for (int cellSize : CELL_SIZES)
+                {
+                    benchmarkGridConfig<Grid>(file, counter, "grid", count, WORLD_SIZE / cellSize, cellSize);
+                }
+
+                // Compile-time power-of-two grid against the runtime grid in the same configuration
+                int staticCells = StaticGrid::Indexer::width();
+                int staticCellSize = StaticGrid::Indexer::cellWidth();
+                benchmarkGridConfig<Grid>(file, counter, "grid", count, staticCells, staticCellSize);
+                benchmarkGridConfig<StaticGrid>(file, counter, "static_grid", count, staticCells, staticCellSize);
+            }
+        }
+
+        void benchmarkStarfield(std::ofstream& file, CacheMissCounter& counter)
+        {
+            SetRandomSeed(5814);
+            Starfield starfield;
+            starfield.initialize(WORLD_SIZE, WORLD_SIZE, 0.5f);
+
+            for (Vector2 viewport : VIEWPORTS)
+            {
+                SetRandomSeed(42);
+                std::vector<Rectangle> frusta = makeFrusta(viewport);
+                std::vector<int> tiles;
+                size_t visitedTiles = 0;
+                long long misses = 0;
+
+                double ns = measureNs(QUERY_COUNT, counter, misses, [&](int i) {
+                    starfield.getVisibleTiles(frusta[i], tiles);
+                    visitedTiles += tiles.size();
+                });
+                report(file, { "starfield_visible_tiles", 0, 0, viewport, QUERY_COUNT, ns / QUERY_COUNT,
+                               visitedTiles / ns, (double)visitedTiles / QUERY_COUNT, misses });
+            }
+        }
+
+        void benchmarkMathUtils(std::ofstream& file, CacheMissCounter& counter)
+        {
+            const int iterations = 1000000;
+            volatile float sink = 0.0f;
+            long long misses = 0;
+
+            double ns = measureNs(iterations, counter, misses, [&](int i) {
+                float sine, cosine;
+                MathUtils::fastSinCos(i * 0.001f, sine, cosine);
+                sink = sink + sine + cosine;
+            });
+            report(file, { "math_fast_sin_cos", 0, 0, { 0, 0 }, iterations, ns / iterations, iterations / ns, 0, misses });
+
+            ns = measureNs(iterations, counter, misses, [&](int i) {
+                sink = sink + sinf(i * 0.001f) + cosf(i * 0.001f);
+            });
+            report(file, { "math_libm_sin_cos", 0, 0, { 0, 0 }, iterations, ns / iterations, iterations / ns, 0, misses });
+
+            ns = measureNs(iterations, counter, misses, [&](int i) {
+                sink = sink + MathUtils::lerp(0.0f, 100.0f, (i & 1023) / 1023.0f);
+            });
+            report(file, { "math_lerp", 0, 0, { 0, 0 }, iterations, ns / iterations, iterations / ns, 0, misses });
+
+            ns = measureNs(iterations, counter, misses, [&](int i) {
+                sink = sink + MathUtils::easeInOut((i & 1023) / 1023.0f);
+            });
+            report(file, { "math_ease_in_out", 0, 0, { 0, 0 }, iterations, ns / iterations, iterations / ns, 0, misses });
+
+            ns = measureNs(iterations, counter, misses, [&](int) {
+                sink = sink + MathUtils::random(0.0f, 1.0f);
+            });
+            report(file, { "math_random", 0, 0, { 0, 0 }, iterations, ns / iterations, iterations / ns, 0, misses });
+        }
+    }
+
+    int run(const std::string& outputPath)
+    {
+        std::ofstream file(outputPath);
+        if (!file)
+        {
+            std::cerr << "Failed to open benchmark output " << outputPath << std::endl;
+            return -1;
+        }
+
+        file << "benchmark,asteroids,cell_size,viewport_w,viewport_h,iterations,"
+            << "ns_per_iteration,objects_per_ns,cells_visited,cache_misses\n";
+
+        CacheMissCounter counter;
+        benchmarkMathUtils(file, counter);
+        benchmarkStarfield(file, counter);
+        benchmarkGrid(file, counter);
+
+        std::cout << "Benchmark results written to " << outputPath << std::endl;
+        return 0;
+    }
+}
\ No newline at end of file
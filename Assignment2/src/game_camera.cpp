@@ -18,12 +18,8 @@ void GameCamera::initialize(Vector2 position, Vector2 viewportSize, Vector2 worl
     m_cameraFrame.y = (m_screenSize.y - m_cameraFrame.height) / 2;
 
     // Calculate the initial frustum (centered around the camera)
-    m_frustum.x = m_position.x - m_viewportSize.x / 2;
-    m_frustum.y = m_position.y - m_viewportSize.y / 2;
-    m_frustum.width = m_viewportSize.x;
-    m_frustum.height = m_viewportSize.y;
-
     clampToWorldBounds();
+    updateFrustum();
 }
 
 void GameCamera::update(Vector2 targetPosition)
@@ -43,6 +39,34 @@ void GameCamera::update(Vector2 targetPosition)
     clampToWorldBounds();
 
     // Update the frustum
+    updateFrustum();
+}
+
+void GameCamera::setState(Vector2 position, Rectangle cameraFrame)
+{
+    m_cameraFrame = cameraFrame;
+    m_position = position;
+    clampToWorldBounds();
+    updateFrustum();
+}
+
+void GameCamera::lookAt(Vector2 position)
+{
+    m_position = position;
+    clampToWorldBounds();
+    updateFrustum();
+}
+
+Vector2 GameCamera::worldToScreen(Vector2 position) const
+{
+    return {
+        m_cameraFrame.x + (position.x - m_position.x + m_viewportSize.x / 2) * (m_cameraFrame.width / m_viewportSize.x),
+        m_cameraFrame.y + (position.y - m_position.y + m_viewportSize.y / 2) * (m_cameraFrame.height / m_viewportSize.y)
+    };
+}
+
+void GameCamera::updateFrustum()
+{
     m_frustum.x = m_position.x - m_viewportSize.x / 2;
     m_frustum.y = m_position.y - m_viewportSize.y / 2;
     m_frustum.width = m_viewportSize.x;
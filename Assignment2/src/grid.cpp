@@ -3,52 +3,77 @@
 #include "grid.hpp"
 #include "game_camera.hpp"
 #include "math_utils.hpp"
+#include "asteroid_shapes.hpp"
 #include <raylib.h>
 #include <iostream>
+#include <algorithm>
+#include <bit>
 
-void Grid::initialize(int width, int height, int cellWidth, int cellHeight, int screen_width, int screen_height)
+template <typename CellIndexer>
+bool BasicGrid<CellIndexer>::initialize(int width, int height, int cellWidth, int cellHeight, int screen_width, int screen_height)
 {
-    m_width = width;
-    m_height = height;
-    m_cellWidth = cellWidth;
-    m_cellHeight = cellHeight;
+    if (!m_indexer.configure(width, height, cellWidth, cellHeight))
+    {
+        std::cout << "Grid dimensions " << width << "x" << height << " with " << cellWidth << "x" << cellHeight
+            << " cells do not match the compile-time configuration, using "
+            << m_indexer.width() << "x" << m_indexer.height() << " with "
+            << m_indexer.cellWidth() << "x" << m_indexer.cellHeight() << " cells" << std::endl;
+        width = m_indexer.width();
+        height = m_indexer.height();
+    }
     m_screen_width = screen_width;
     m_screen_height = screen_height;
 
+    // Larger cell indices would not fit into an asteroid id
+    if ((long long)width * height > MAX_CELLS)
+    {
+        std::cerr << "Grid of " << width << "x" << height << " cells exceeds the " << MAX_CELLS << " cells asteroid ids can address" << std::endl;
+        return false;
+    }
+
     m_cells.resize(width * height);
+    m_cellDirty.assign(width * height, false);
+    m_usage.set(getUsedBytes());
 
     std::cout << "Grid initialized: " << width << "x" << height
         << " (" << width * height << " cells)" << std::endl;
+    return true;
 }
 
-void Grid::generateAsteroids(int count)
+template <typename CellIndexer>
+void BasicGrid<CellIndexer>::generateAsteroids(int count)
 {
+    int dropped = 0;
     for (int i = 0; i < count; i++)
     {
         Asteroid asteroid;
 
         // Random position within world bounds
         Vector2 position = {
-            (float)MathUtils::random(0, m_width * m_cellWidth),
-            (float)MathUtils::random(0, m_height * m_cellHeight)
+            (float)MathUtils::random(0, m_indexer.width() * m_indexer.cellWidth()),
+            (float)MathUtils::random(0, m_indexer.height() * m_indexer.cellHeight())
         };
 
         // Random size
         float sizeType = (float)MathUtils::random(0, 3);
         Vector2 size;
         int layer;
+        int sizeClass;
 
         if (sizeType < 1.0f) {
             size = { 20, 20 };
             layer = 1; // Background layer
+            sizeClass = 0;
         }
         else if (sizeType < 2.0f) {
             size = { 40, 40 };
             layer = 2; // Middle layer
+            sizeClass = 1;
         }
         else {
             size = { 60, 60 };
             layer = 3; // Foreground layer
+            sizeClass = 2;
         }
 
         // Random rotation and rotation direction
@@ -62,23 +87,41 @@ void Grid::generateAsteroids(int count)
         unsigned char gray = (unsigned char)MathUtils::random(150, 230);
         Color color = { gray, gray, gray, 255 };
 
-        asteroid.initialize(position, size, rotation, rotationSpeed, color, layer);
+        // Outline shared with the other asteroids of the size class
+        unsigned char shapeId = AsteroidShapes::pick(sizeClass);
+
+        asteroid.initialize(position, size, rotation, rotationSpeed, color, layer, shapeId);
 
         // Add to corresponding grid cell
         int gridX, gridY;
         worldToGrid(position, gridX, gridY);
 
-        if (gridX >= 0 && gridX < m_width && gridY >= 0 && gridY < m_height)
+        if (gridX >= 0 && gridX < m_indexer.width() && gridY >= 0 && gridY < m_indexer.height())
         {
-            int index = gridY * m_width + gridX;
+            int index = m_indexer.cellIndex(gridX, gridY);
+
+            // The slot of a further asteroid would not fit into its id
+            if ((int)m_cells[index].asteroids.size() >= MAX_ASTEROIDS_PER_CELL)
+            {
+                dropped++;
+                continue;
+            }
+
             m_cells[index].asteroids.push_back(asteroid);
+            markCellDirty(index);
         }
     }
 
-    std::cout << "Generated " << count << " asteroids" << std::endl;
+    if (dropped > 0)
+    {
+        std::cerr << "Dropped " << dropped << " asteroids, a cell holds at most " << MAX_ASTEROIDS_PER_CELL << std::endl;
+    }
+    m_usage.set(getUsedBytes());
+    std::cout << "Generated " << count - dropped << " asteroids" << std::endl;
 }
 
-void Grid::updateAsteroids()
+template <typename CellIndexer>
+void BasicGrid<CellIndexer>::updateAsteroids()
 {
     for (auto& cell : m_cells)
     {
@@ -89,24 +132,28 @@ void Grid::updateAsteroids()
     }
 }
 
-std::vector<Asteroid> Grid::getVisibleAsteroids(const Rectangle& frustum) const
+template <typename CellIndexer>
+std::vector<Asteroid> BasicGrid<CellIndexer>::getVisibleAsteroids(const Rectangle& frustum) const
 {
     std::vector<Asteroid> result;
+    m_lastQueryStats = GridQueryStats();
 
     // Calculate grid range covered by the frustum
-    int startX = std::max(0, static_cast<int>(frustum.x) / m_cellWidth);
-    int endX = std::min(m_width - 1, static_cast<int>(frustum.x + frustum.width) / m_cellWidth);
+    int startX = std::max(0, m_indexer.cellX(static_cast<int>(frustum.x)));
+    int endX = std::min(m_indexer.width() - 1, m_indexer.cellX(static_cast<int>(frustum.x + frustum.width)));
 
-    int startY = std::max(0, static_cast<int>(frustum.y) / m_cellHeight);
-    int endY = std::min(m_height - 1, static_cast<int>(frustum.y + frustum.height) / m_cellHeight);
+    int startY = std::max(0, m_indexer.cellY(static_cast<int>(frustum.y)));
+    int endY = std::min(m_indexer.height() - 1, m_indexer.cellY(static_cast<int>(frustum.y + frustum.height)));
 
     // Iterate through visible grid cells
     for (int y = startY; y <= endY; y++)
     {
         for (int x = startX; x <= endX; x++)
         {
-            int index = y * m_width + x;
+            int index = m_indexer.cellIndex(x, y);
             const auto& cell = m_cells[index];
+            m_lastQueryStats.cellsVisited++;
+            m_lastQueryStats.asteroidsTested += (int)cell.asteroids.size();
 
             // Check if each asteroid is within the frustum
             for (const auto& asteroid : cell.asteroids)
@@ -129,9 +176,106 @@ std::vector<Asteroid> Grid::getVisibleAsteroids(const Rectangle& frustum) const
     return result;
 }
 
-void Grid::renderDebug(const GameCamera& camera) const
+template <typename CellIndexer>
+template <typename Visitor>
+void BasicGrid<CellIndexer>::visitVisible(const std::vector<Rectangle>& frusta, Visitor visit) const
+{
+    int cameraCount = std::min(static_cast<int>(frusta.size()), MAX_CAMERAS);
+    m_lastQueryStats = GridQueryStats();
+
+    if (cameraCount == 0) return;
+
+    // Calculate the union of the grid ranges covered by all frusta
+    int startX = m_indexer.width(), endX = -1;
+    int startY = m_indexer.height(), endY = -1;
+    for (int i = 0; i < cameraCount; i++)
+    {
+        const Rectangle& frustum = frusta[i];
+        startX = std::min(startX, std::max(0, m_indexer.cellX(static_cast<int>(frustum.x))));
+        endX = std::max(endX, std::min(m_indexer.width() - 1, m_indexer.cellX(static_cast<int>(frustum.x + frustum.width))));
+        startY = std::min(startY, std::max(0, m_indexer.cellY(static_cast<int>(frustum.y))));
+        endY = std::max(endY, std::min(m_indexer.height() - 1, m_indexer.cellY(static_cast<int>(frustum.y + frustum.height))));
+    }
+
+    for (int y = startY; y <= endY; y++)
+    {
+        for (int x = startX; x <= endX; x++)
+        {
+            // Tag the cell with every camera that can see it, skip cells between the frusta
+            unsigned int cellMask = 0;
+            for (int i = 0; i < cameraCount; i++)
+            {
+                if (isCellVisible(x, y, frusta[i])) cellMask |= 1u << i;
+            }
+
+            if (cellMask == 0) continue;
+
+            int index = m_indexer.cellIndex(x, y);
+            const auto& cell = m_cells[index];
+            m_lastQueryStats.cellsVisited++;
+            m_lastQueryStats.asteroidsTested += (int)cell.asteroids.size();
+
+            for (int slot = 0; slot < (int)cell.asteroids.size(); slot++)
+            {
+                const Asteroid& asteroid = cell.asteroids[slot];
+                Rectangle asteroidRect = {
+                    asteroid.position.x - asteroid.size.x / 2,
+                    asteroid.position.y - asteroid.size.y / 2,
+                    asteroid.size.x,
+                    asteroid.size.y
+                };
+
+                // Only test the cameras that see this cell
+                for (unsigned int bits = cellMask; bits != 0; bits &= bits - 1)
+                {
+                    int camera = std::countr_zero(bits);
+                    if (CheckCollisionRecs(asteroidRect, frusta[camera])) visit(camera, index, slot, asteroid);
+                }
+            }
+        }
+    }
+}
+
+template <typename CellIndexer>
+void BasicGrid<CellIndexer>::getVisibleAsteroids(const std::vector<Rectangle>& frusta,
+                                                 std::vector<std::vector<Asteroid>>& visiblePerCamera) const
+{
+    visiblePerCamera.resize(frusta.size());
+    for (auto& visible : visiblePerCamera)
+    {
+        visible.clear();
+    }
+
+    visitVisible(frusta, [&](int camera, int, int, const Asteroid& asteroid) {
+        visiblePerCamera[camera].push_back(asteroid);
+    });
+}
+
+template <typename CellIndexer>
+void BasicGrid<CellIndexer>::getVisibleAsteroidIds(const std::vector<Rectangle>& frusta,
+                                                   std::vector<std::vector<unsigned int>>& idsPerCamera) const
+{
+    idsPerCamera.resize(frusta.size());
+    for (auto& ids : idsPerCamera)
+    {
+        ids.clear();
+    }
+
+    // Cells are visited in increasing index order and slots in order, so the ids come out sorted
+    visitVisible(frusta, [&](int camera, int cellIndex, int slot, const Asteroid&) {
+        idsPerCamera[camera].push_back(((unsigned int)cellIndex << ASTEROID_SLOT_BITS) | (unsigned int)slot);
+    });
+}
+
+template <typename CellIndexer>
+const Asteroid& BasicGrid<CellIndexer>::getAsteroid(unsigned int id) const
+{
+    return m_cells[id >> ASTEROID_SLOT_BITS].asteroids[id & ((1u << ASTEROID_SLOT_BITS) - 1)];
+}
+
+template <typename CellIndexer>
+void BasicGrid<CellIndexer>::renderDebug(const GameCamera& camera) const
 {
-    Rectangle frustum = camera.getFrustum();
     Rectangle cameraFrame = camera.getCameraFrame();
 
     // Draw grid lines
@@ -140,9 +284,9 @@ void Grid::renderDebug(const GameCamera& camera) const
     // Calculate conversion ratio from world coordinates to camera frame coordinates
     float scaleX = cameraFrame.width / viewportSize.x;
     float scaleY = cameraFrame.height / viewportSize.y;
-    for (int x = 0; x <= m_width; x++)
+    for (int x = 0; x <= m_indexer.width(); x++)
     {
-        int worldX = x * m_cellWidth;
+        int worldX = x * m_indexer.cellWidth();
 
         // Convert world coordinates to screen coordinates
         int screenX1 = (int)(cameraFrame.x + (worldX - cameraPos.x + viewportSize.x / 2) * scaleX);
@@ -157,9 +301,9 @@ void Grid::renderDebug(const GameCamera& camera) const
         }
     }
 
-    for (int y = 0; y <= m_height; y++)
+    for (int y = 0; y <= m_indexer.height(); y++)
     {
-        int worldY = y * m_cellHeight;
+        int worldY = y * m_indexer.cellHeight();
 
         // Convert world coordinates to screen coordinates
         int screenX1 = (int)cameraFrame.x;
@@ -173,53 +317,60 @@ void Grid::renderDebug(const GameCamera& camera) const
             DrawLine(screenX1, screenY1, screenX2, screenY2, Fade(DARKGRAY, 0.5f));
         }
     }
+}
 
-    // Draw minimap
-    int miniMapSize = m_screen_width / 10;
-    int miniMapX = m_screen_width - miniMapSize;
-    int miniMapY = 0;
-    DrawRectangle(miniMapX, miniMapY, miniMapSize, miniMapSize, Fade(BLACK, 0.5f));
-
-    // Calculate scaling factor
-    float scale = static_cast<float>(miniMapSize) / (m_width * m_cellWidth);
+template <typename CellIndexer>
+void BasicGrid<CellIndexer>::takeDirtyCells(std::vector<int>& dirtyCells)
+{
+    dirtyCells.clear();
+    dirtyCells.swap(m_dirtyCells);
 
-    // Draw grid
-    for (int x = 0; x <= m_width; x++)
+    for (int index : dirtyCells)
     {
-        int lineX = miniMapX + (int)(x * m_cellWidth * scale);
-        DrawLine(lineX, miniMapY, lineX, miniMapY + miniMapSize, DARKGRAY);
+        m_cellDirty[index] = false;
     }
+}
 
-    for (int y = 0; y <= m_height; y++)
+template <typename CellIndexer>
+void BasicGrid<CellIndexer>::markCellDirty(int index)
+{
+    if (m_cellDirty[index]) return;
+
+    m_cellDirty[index] = true;
+    m_dirtyCells.push_back(index);
+}
+
+template <typename CellIndexer>
+size_t BasicGrid<CellIndexer>::getUsedBytes() const
+{
+    size_t bytes = MemoryTracker::usedBytes(m_cells);
+    for (const auto& cell : m_cells)
     {
-        int lineY = miniMapY + (int)(y * m_cellHeight * scale);
-        DrawLine(miniMapX, lineY, miniMapX + miniMapSize, lineY, DARKGRAY);
+        bytes += MemoryTracker::usedBytes(cell.asteroids);
     }
-
-    // Draw frustum on minimap
-    Rectangle miniFrustum = {
-        miniMapX + frustum.x * scale,
-        miniMapY + frustum.y * scale,
-        frustum.width * scale,
-        frustum.height * scale
-    };
-    DrawRectangleLinesEx(miniFrustum, 1, GREEN);
+    return bytes;
 }
 
-void Grid::worldToGrid(const Vector2& position, int& gridX, int& gridY) const
+template <typename CellIndexer>
+void BasicGrid<CellIndexer>::worldToGrid(const Vector2& position, int& gridX, int& gridY) const
 {
-    gridX = static_cast<int>(position.x) / m_cellWidth;
-    gridY = static_cast<int>(position.y) / m_cellHeight;
+    gridX = m_indexer.cellX(static_cast<int>(position.x));
+    gridY = m_indexer.cellY(static_cast<int>(position.y));
 }
 
-bool Grid::isCellVisible(int gridX, int gridY, const Rectangle& frustum) const
+template <typename CellIndexer>
+bool BasicGrid<CellIndexer>::isCellVisible(int gridX, int gridY, const Rectangle& frustum) const
 {
     Rectangle cellRect = {
-        static_cast<float>(gridX * m_cellWidth),
-        static_cast<float>(gridY * m_cellHeight),
-        static_cast<float>(m_cellWidth),
-        static_cast<float>(m_cellHeight)
+        static_cast<float>(gridX * m_indexer.cellWidth()),
+        static_cast<float>(gridY * m_indexer.cellHeight()),
+        static_cast<float>(m_indexer.cellWidth()),
+        static_cast<float>(m_indexer.cellHeight())
     };
 
     return CheckCollisionRecs(cellRect, frustum);
-}
\ No newline at end of file
+}
+
+// Instantiate the runtime and the compile-time configured grids
+template class BasicGrid<RuntimeCellIndexer>;
+template class BasicGrid<Pow2CellIndexer<10, 10, 10>>;
\ No newline at end of file
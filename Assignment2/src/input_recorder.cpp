@@ -0,0 +1,170 @@
+// input_recorder.cpp
+
+#include "input_recorder.hpp"
+#include <raylib.h>
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+
+namespace
+{
+    // File layout: magic, version, seed, tick count, then one byte of InputFlags per tick
+    const char RECORDING_MAGIC[4] = { 'A', 'F', 'I', 'R' };
+    const uint32_t RECORDING_VERSION = 1;
+
+    float percentile(std::vector<float> values, float fraction)
+    {
+        if (values.empty()) return 0.0f;
+
+        size_t index = std::min(values.size() - 1, (size_t)(fraction * values.size()));
+        std::nth_element(values.begin(), values.begin() + index, values.end());
+        return values[index];
+    }
+}
+
+bool InputRecorder::startRecording(const std::string& path, unsigned int seed)
+{
+    m_mode = Mode::Record;
+    m_path = path;
+    m_seed = seed;
+    m_ticks.clear();
+    m_tick = 0;
+
+    std::cout << "Recording input to " << path << " (seed " << seed << ")" << std::endl;
+    return true;
+}
+
+bool InputRecorder::startPlayback(const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+    {
+        std::cerr << "Failed to open input recording " << path << std::endl;
+        return false;
+    }
+
+    char magic[4];
+    uint32_t version = 0, seed = 0, tickCount = 0;
+    file.read(magic, sizeof(magic));
+    file.read(reinterpret_cast<char*>(&version), sizeof(version));
+    file.read(reinterpret_cast<char*>(&seed), sizeof(seed));
+    file.read(reinterpret_cast<char*>(&tickCount), sizeof(tickCount));
+
+    if (!file || !std::equal(magic, magic + 4, RECORDING_MAGIC) || version != RECORDING_VERSION)
+    {
+        std::cerr << "Invalid input recording " << path << std::endl;
+        return false;
+    }
+
+    std::vector<unsigned char> ticks(tickCount);
+    file.read(reinterpret_cast<char*>(ticks.data()), tickCount);
+    if (!file)
+    {
+        std::cerr << "Truncated input recording " << path << std::endl;
+        return false;
+    }
+
+    m_mode = Mode::Playback;
+    m_path = path;
+    m_seed = seed;
+    m_ticks.swap(ticks);
+    m_tick = 0;
+
+    std::cout << "Replaying " << tickCount << " ticks from " << path << " (seed " << seed << ")" << std::endl;
+    return true;
+}
+
+unsigned char InputRecorder::nextTick()
+{
+    switch (m_mode)
+    {
+    case Mode::Record:
+        m_ticks.push_back(pollKeyboard());
+        return m_ticks[m_tick++];
+
+    case Mode::Playback:
+        if (m_tick >= (int)m_ticks.size()) return 0;
+        return m_ticks[m_tick++];
+
+    default:
+        return pollKeyboard();
+    }
+}
+
+float InputRecorder::getTimestep() const
+{
+    return isDeterministic() ? FIXED_TIMESTEP : GetFrameTime();
+}
+
+void InputRecorder::recordFrameTime(double workSeconds, float frameSeconds)
+{
+    if (!isDeterministic()) return;
+
+    m_workTimes.push_back((float)(workSeconds * 1000.0));
+    m_frameTimes.push_back(frameSeconds * 1000.0f);
+}
+
+void InputRecorder::finish()
+{
+    if (m_mode == Mode::Record)
+    {
+        std::ofstream file(m_path, std::ios::binary);
+        uint32_t tickCount = (uint32_t)m_ticks.size();
+        uint32_t seed = m_seed;
+
+        file.write(RECORDING_MAGIC, sizeof(RECORDING_MAGIC));
+        file.write(reinterpret_cast<const char*>(&RECORDING_VERSION), sizeof(RECORDING_VERSION));
+        file.write(reinterpret_cast<const char*>(&seed), sizeof(seed));
+        file.write(reinterpret_cast<const char*>(&tickCount), sizeof(tickCount));
+        file.write(reinterpret_cast<const char*>(m_ticks.data()), tickCount);
+
+        if (file) std::cout << "Saved " << tickCount << " ticks of input to " << m_path << std::endl;
+        else std::cerr << "Failed to write input recording " << m_path << std::endl;
+    }
+
+    if (isDeterministic()) writeFrameTimes();
+}
+
+unsigned char InputRecorder::pollKeyboard() const
+{
+    unsigned char input = 0;
+
+    // Player control
+    if (IsKeyDown(KEY_W)) input |= INPUT_THRUST;
+    if (IsKeyDown(KEY_A)) input |= INPUT_ROTATE_LEFT;
+    if (IsKeyDown(KEY_D)) input |= INPUT_ROTATE_RIGHT;
+
+    // Display toggles change the frame cost, so they are part of the recording too
+    if (IsKeyPressed(KEY_F1)) input |= INPUT_TOGGLE_DEBUG;
+    if (IsKeyPressed(KEY_F2)) input |= INPUT_TOGGLE_SPECTATOR;
+    if (IsKeyPressed(KEY_F3)) input |= INPUT_TOGGLE_OVERDRAW;
+
+    return input;
+}
+
+void InputRecorder::writeFrameTimes() const
+{
+    if (m_workTimes.empty()) return;
+
+    // One row per tick, next to the recording
+    std::string reportPath = m_path + (m_mode == Mode::Record ? ".record.csv" : ".replay.csv");
+    std::ofstream report(reportPath);
+    report << "tick,work_ms,frame_ms\n";
+    for (size_t i = 0; i < m_workTimes.size(); i++)
+    {
+        report << i << "," << m_workTimes[i] << "," << m_frameTimes[i] << "\n";
+    }
+
+    double total = 0.0;
+    for (float time : m_workTimes) total += time;
+
+    std::cout << "Frame work time over " << m_workTimes.size() << " ticks (ms): "
+        << "avg " << total / m_workTimes.size()
+        << ", p50 " << percentile(m_workTimes, 0.50f)
+        << ", p95 " << percentile(m_workTimes, 0.95f)
+        << ", p99 " << percentile(m_workTimes, 0.99f)
+        << ", max " << *std::max_element(m_workTimes.begin(), m_workTimes.end())
+        << std::endl;
+    std::cout << "Frame times written to " << reportPath << std::endl;
+}
\ No newline at end of file
@@ -0,0 +1,132 @@
+// loopback.cpp
+
+#include "loopback.hpp"
+#include "simulation_server.hpp"
+#include "remote_world.hpp"
+#include "input_recorder.hpp"
+#include "grid.hpp"
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace Loopback
+{
+    namespace
+    {
+        const int SCREEN_WIDTH = 1280;
+        const int SCREEN_HEIGHT = 720;
+        const Vector2 VIEWPORTS[] = { { 640, 360 }, { 1280, 720 }, { 2560, 1440 } };
+
+        struct TestClient
+        {
+            RemoteWorld world;
+            GameCamera camera;      // Mirrors the camera the server culls for this client
+            Vector2 viewportSize;
+            long long visibleTotal = 0;
+            int mismatches = 0;
+        };
+
+        // Thrust all the time and turn now and then, so the view keeps sweeping new cells
+        unsigned char scriptedInput(unsigned int tick)
+        {
+            unsigned char input = INPUT_THRUST;
+            if (tick % 240 < 40) input |= INPUT_ROTATE_RIGHT;
+            return input;
+        }
+    }
+
+    int run(int clientCount, int tickCount)
+    {
+        if (!TcpSocket::startup()) return -1;
+
+        SimulationServer server;
+        if (!server.initialize(NetProtocol::DEFAULT_PORT, SCREEN_WIDTH, SCREEN_HEIGHT))
+        {
+            TcpSocket::cleanup();
+            return -1;
+        }
+
+        // Reference world generated from the same seed, only used for culling
+        SetRandomSeed(InputRecorder::DEFAULT_SEED);
+        WorldGrid reference;
+        if (!reference.initialize(WORLD_CELL_COUNT, WORLD_CELL_COUNT, WORLD_CELL_SIZE, WORLD_CELL_SIZE, SCREEN_WIDTH, SCREEN_HEIGHT))
+        {
+            server.shutdown();
+            TcpSocket::cleanup();
+            return -1;
+        }
+        reference.generateAsteroids(6000);
+
+        // Extra ticks leave time for the clients to connect
+        std::thread serverThread([&server, tickCount]() { server.run(tickCount + 120); });
+
+        std::vector<std::unique_ptr<TestClient>> clients;
+        for (int i = 0; i < clientCount; i++)
+        {
+            auto client = std::make_unique<TestClient>();
+            client->viewportSize = VIEWPORTS[i % 3];
+            if (!client->world.connect("127.0.0.1", NetProtocol::DEFAULT_PORT, client->viewportSize)) break;
+
+            Vector2 worldSize = client->world.getWorldSize();
+            client->camera.initialize(client->world.getPlayerPosition(), client->viewportSize, worldSize, client->viewportSize);
+            clients.push_back(std::move(client));
+        }
+
+        std::vector<Rectangle> frustum(1);
+        std::vector<std::vector<unsigned int>> expected;
+        bool running = (int)clients.size() == clientCount;
+
+        while (running)
+        {
+            running = false;
+            for (auto& client : clients)
+            {
+                if (client.get() == clients[0].get()) client->world.sendInput(scriptedInput(client->world.getTick()));
+
+                while (client->world.applyNextSnapshot())
+                {
+                    client->camera.update(client->world.getPlayerPosition());
+                    if (client->world.hasCameraState())
+                    {
+                        client->camera.setState(client->world.getCameraPosition(), client->world.getCameraFrame());
+                    }
+                    frustum[0] = client->camera.getFrustum();
+                    reference.getVisibleAsteroidIds(frustum, expected);
+
+                    if (expected[0] != client->world.getAsteroidIds()) client->mismatches++;
+                    client->visibleTotal += client->world.getAsteroidIds().size();
+                }
+
+                if (client->world.isConnected() && client->world.getSnapshotCount() < tickCount) running = true;
+            }
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        // Disconnect before the server stops, so it does not keep sending
+        int mismatches = (int)clients.size() == clientCount ? 0 : 1;
+        for (size_t i = 0; i < clients.size(); i++)
+        {
+            TestClient& client = *clients[i];
+            int snapshots = client.world.getSnapshotCount();
+            mismatches += client.mismatches;
+
+            std::cout << "Client " << i << " (" << client.viewportSize.x << "x" << client.viewportSize.y << "): "
+                << snapshots << " snapshots, "
+                << (snapshots > 0 ? (double)client.visibleTotal / snapshots : 0.0) << " visible on average, "
+                << (snapshots > 0 ? (double)client.world.getBytesReceived() / snapshots : 0.0) << " bytes per snapshot, "
+                << client.mismatches << " mismatched snapshots" << std::endl;
+
+            client.world.disconnect();
+        }
+
+        serverThread.join();
+        server.shutdown();
+        TcpSocket::cleanup();
+
+        std::cout << (mismatches == 0 ? "Loopback test passed" : "Loopback test FAILED") << std::endl;
+        return mismatches == 0 ? 0 : -1;
+    }
+}
\ No newline at end of file
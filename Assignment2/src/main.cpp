@@ -1,17 +1,73 @@
 // main.cpp
 
 #include "application.hpp"
+#include "benchmark.hpp"
+#include "simulation_server.hpp"
+#include "loopback.hpp"
 #include <raylib.h>
+#include <cstdlib>
+#include <cstring>
 
 int main(int argc, char** argv)
 {
+    // --bench [file] runs the microbenchmarks without opening a window
+    if (argc > 1 && strcmp(argv[1], "--bench") == 0)
+    {
+        return Benchmark::run(argc > 2 ? argv[2] : "bench_results.csv");
+    }
+
     // Set window size
     int width = 1280;
     int height = 720;
+
+    // --server [port] simulates the world without a window for clients started with --connect
+    if (argc > 1 && strcmp(argv[1], "--server") == 0)
+    {
+        if (!TcpSocket::startup()) return -1;
+
+        SimulationServer server;
+        int port = argc > 2 ? atoi(argv[2]) : NetProtocol::DEFAULT_PORT;
+        if (!server.initialize(port, width, height))
+        {
+            TcpSocket::cleanup();
+            return -1;
+        }
+
+        server.run(0);
+        server.shutdown();
+        TcpSocket::cleanup();
+        return 0;
+    }
+
+    // --loopback [clients] [ticks] tests the server with headless clients in this process
+    if (argc > 1 && strcmp(argv[1], "--loopback") == 0)
+    {
+        return Loopback::run(argc > 2 ? atoi(argv[2]) : 3, argc > 3 ? atoi(argv[3]) : 600);
+    }
+
     InitWindow(width, height, "Asteroid Field Renderer");
     SetTargetFPS(60);
 
     Application app;
+
+    // --record <file> saves the input of this run, --replay <file> plays it back,
+    // --connect <host[:port]> renders the world of a server,
+    // --budget <ms> sets the frame time the quality governor holds (0 turns it off)
+    for (int i = 1; i + 1 < argc; i++)
+    {
+        bool started = true;
+        if (strcmp(argv[i], "--record") == 0) started = app.recordInput(argv[i + 1]);
+        else if (strcmp(argv[i], "--replay") == 0) started = app.replayInput(argv[i + 1]);
+        else if (strcmp(argv[i], "--connect") == 0) app.connectToServer(argv[i + 1]);
+        else if (strcmp(argv[i], "--budget") == 0) app.setFrameBudget(atof(argv[i + 1]));
+
+        if (!started)
+        {
+            CloseWindow();
+            return -1;
+        }
+    }
+
     if (!app.initialize(width, height))
     {
         CloseWindow();
@@ -19,7 +75,7 @@ int main(int argc, char** argv)
     }
 
     // Main loop
-    while (!WindowShouldClose())
+    while (!WindowShouldClose() && !app.isReplayFinished() && !app.isDisconnected())
     {
         app.update();
 
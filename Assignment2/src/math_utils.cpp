@@ -4,9 +4,38 @@
 #include <raylib.h>
 #include <random>
 #include <algorithm>
+#include <array>
+#include <cmath>
 
 namespace MathUtils
 {
+    namespace
+    {
+        constexpr int SIN_TABLE_SIZE = 4096;  // Must be a power of two
+        constexpr float TWO_PI = 6.28318530718f;
+
+        // One full turn of sine plus a quarter turn so cosine can share the table,
+        // and one extra sample so interpolation never wraps
+        struct SinTable
+        {
+            std::array<float, SIN_TABLE_SIZE + SIN_TABLE_SIZE / 4 + 1> values;
+
+            SinTable()
+            {
+                for (size_t i = 0; i < values.size(); i++)
+                {
+                    values[i] = static_cast<float>(std::sin(static_cast<double>(i) * 6.283185307179586 / SIN_TABLE_SIZE));
+                }
+            }
+        };
+
+        const SinTable& sinTable()
+        {
+            static const SinTable table;
+            return table;
+        }
+    }
+
     float random(float min, float max)
     {
         return min + static_cast<float>(GetRandomValue(0, 10000)) / 10000.0f * (max - min);
@@ -58,4 +87,37 @@ namespace MathUtils
         if (value > max) return max;
         return value;
     }
-}
\ No newline at end of file
+
+    void fastSinCos(float radians, float& sine, float& cosine)
+    {
+        const auto& table = sinTable().values;
+
+        float t = radians * (SIN_TABLE_SIZE / TWO_PI);
+        float base = std::floor(t);
+        float frac = t - base;
+        int index = static_cast<int>(base) & (SIN_TABLE_SIZE - 1);
+
+        sine = table[index] + (table[index + 1] - table[index]) * frac;
+
+        int cosIndex = index + SIN_TABLE_SIZE / 4;
+        cosine = table[cosIndex] + (table[cosIndex + 1] - table[cosIndex]) * frac;
+    }
+
+    float fastSinCosMaxError()
+    {
+        float maxError = 0.0f;
+        const int samples = SIN_TABLE_SIZE * 16;
+
+        for (int i = -samples; i <= samples; i++)
+        {
+            float angle = static_cast<float>(i) * TWO_PI / samples;
+            float sine, cosine;
+            fastSinCos(angle, sine, cosine);
+
+            maxError = std::max(maxError, std::fabs(sine - sinf(angle)));
+            maxError = std::max(maxError, std::fabs(cosine - cosf(angle)));
+        }
+
+        return maxError;
+    }
+}
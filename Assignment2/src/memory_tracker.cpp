@@ -0,0 +1,95 @@
+// memory_tracker.cpp
+
+#include "memory_tracker.hpp"
+#include <atomic>
+
+namespace
+{
+    struct Counters
+    {
+        std::atomic<long long> usedBytes{ 0 };
+        std::atomic<long long> reservedBytes{ 0 };
+        std::atomic<long long> peakReservedBytes{ 0 };
+        std::atomic<long long> allocations{ 0 };
+        std::atomic<long long> deallocations{ 0 };
+    };
+
+    Counters g_counters[(int)MemorySubsystem::Count];
+
+    // Indexed by MemorySubsystem
+    const char* SUBSYSTEM_NAMES[] = { "grid cells", "stars", "render commands" };
+
+    double toKiB(long long bytes)
+    {
+        return (double)bytes / 1024.0;
+    }
+}
+
+void MemoryTracker::recordAllocation(MemorySubsystem subsystem, size_t bytes)
+{
+    Counters& counters = g_counters[(int)subsystem];
+    counters.allocations.fetch_add(1, std::memory_order_relaxed);
+    long long reserved = counters.reservedBytes.fetch_add((long long)bytes, std::memory_order_relaxed) + (long long)bytes;
+
+    // Raise the peak unless another thread already raised it further
+    long long peak = counters.peakReservedBytes.load(std::memory_order_relaxed);
+    while (reserved > peak && !counters.peakReservedBytes.compare_exchange_weak(peak, reserved, std::memory_order_relaxed))
+    {
+    }
+}
+
+void MemoryTracker::recordDeallocation(MemorySubsystem subsystem, size_t bytes)
+{
+    Counters& counters = g_counters[(int)subsystem];
+    counters.deallocations.fetch_add(1, std::memory_order_relaxed);
+    counters.reservedBytes.fetch_sub((long long)bytes, std::memory_order_relaxed);
+}
+
+void MemoryTracker::addUsedBytes(MemorySubsystem subsystem, size_t bytes)
+{
+    g_counters[(int)subsystem].usedBytes.fetch_add((long long)bytes, std::memory_order_relaxed);
+}
+
+void MemoryTracker::removeUsedBytes(MemorySubsystem subsystem, size_t bytes)
+{
+    g_counters[(int)subsystem].usedBytes.fetch_sub((long long)bytes, std::memory_order_relaxed);
+}
+
+MemoryStats MemoryTracker::getStats(MemorySubsystem subsystem)
+{
+    const Counters& counters = g_counters[(int)subsystem];
+    MemoryStats stats;
+    stats.usedBytes = counters.usedBytes.load(std::memory_order_relaxed);
+    stats.reservedBytes = counters.reservedBytes.load(std::memory_order_relaxed);
+    stats.peakReservedBytes = counters.peakReservedBytes.load(std::memory_order_relaxed);
+    stats.allocations = counters.allocations.load(std::memory_order_relaxed);
+    stats.deallocations = counters.deallocations.load(std::memory_order_relaxed);
+    return stats;
+}
+
+const char* MemoryTracker::getName(MemorySubsystem subsystem)
+{
+    return SUBSYSTEM_NAMES[(int)subsystem];
+}
+
+void MemoryTracker::report(std::ostream& out)
+{
+    MemoryStats total;
+    out << "Memory (KiB used / reserved, peak reserved, allocations / frees):" << std::endl;
+
+    for (int i = 0; i < (int)MemorySubsystem::Count; i++)
+    {
+        MemoryStats stats = getStats((MemorySubsystem)i);
+        out << "  " << SUBSYSTEM_NAMES[i] << ": " << toKiB(stats.usedBytes) << " / " << toKiB(stats.reservedBytes)
+            << ", peak " << toKiB(stats.peakReservedBytes)
+            << ", " << stats.allocations << " / " << stats.deallocations << std::endl;
+
+        total.usedBytes += stats.usedBytes;
+        total.reservedBytes += stats.reservedBytes;
+        total.peakReservedBytes += stats.peakReservedBytes;
+    }
+
+    // Peaks of different subsystems need not coincide, their sum is an upper bound
+    out << "  total: " << toKiB(total.usedBytes) << " / " << toKiB(total.reservedBytes)
+        << ", peak at most " << toKiB(total.peakReservedBytes) << std::endl;
+}
\ No newline at end of file
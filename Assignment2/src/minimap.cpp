@@ -0,0 +1,161 @@
+// minimap.cpp
+
+#include "minimap.hpp"
+#include <raylib.h>
+#include <algorithm>
+
+void Minimap::initialize(const WorldGrid& grid, Rectangle screenRect)
+{
+    m_screenRect = screenRect;
+    m_gridWidth = grid.getWidth();
+    m_gridHeight = grid.getHeight();
+    m_worldSize = {
+        (float)(m_gridWidth * grid.getCellWidth()),
+        (float)(m_gridHeight * grid.getCellHeight())
+    };
+
+    m_cellCounts.assign(m_gridWidth * m_gridHeight, 0);
+    m_densityPixels.assign(m_gridWidth * m_gridHeight, densityColor(0));
+    m_maxCount = 1;
+
+    // Point filtering keeps the cells as sharp squares when scaled up
+    Image image = GenImageColor(m_gridWidth, m_gridHeight, densityColor(0));
+    m_densityTexture = LoadTextureFromImage(image);
+    UnloadImage(image);
+    SetTextureFilter(m_densityTexture, TEXTURE_FILTER_POINT);
+
+    m_cache = LoadRenderTexture((int)m_screenRect.width, (int)m_screenRect.height);
+    rebuildCache();
+}
+
+void Minimap::shutdown()
+{
+    UnloadRenderTexture(m_cache);
+    UnloadTexture(m_densityTexture);
+}
+
+void Minimap::update(WorldGrid& grid)
+{
+    grid.takeDirtyCells(m_dirtyCells);
+    for (int index : m_dirtyCells)
+    {
+        m_cellCounts[index] = grid.getAsteroidCount(index);
+    }
+
+    uploadDirtyCells();
+}
+
+void Minimap::setCellCounts(const std::vector<int>& cellCounts)
+{
+    m_dirtyCells.clear();
+    for (int i = 0; i < (int)std::min(cellCounts.size(), m_cellCounts.size()); i++)
+    {
+        if (cellCounts[i] == m_cellCounts[i]) continue;
+
+        m_cellCounts[i] = cellCounts[i];
+        m_dirtyCells.push_back(i);
+    }
+
+    uploadDirtyCells();
+}
+
+void Minimap::uploadDirtyCells()
+{
+    if (m_dirtyCells.empty()) return;
+
+    // A new densest cell changes the color scale of every cell
+    bool rescaled = false;
+    for (int index : m_dirtyCells)
+    {
+        if (m_cellCounts[index] > m_maxCount)
+        {
+            m_maxCount = m_cellCounts[index];
+            rescaled = true;
+        }
+    }
+
+    if (rescaled || (int)m_dirtyCells.size() * 2 > (int)m_densityPixels.size())
+    {
+        // Upload the whole texture
+        for (size_t i = 0; i < m_densityPixels.size(); i++)
+        {
+            m_densityPixels[i] = densityColor(m_cellCounts[i]);
+        }
+        UpdateTexture(m_densityTexture, m_densityPixels.data());
+    }
+    else
+    {
+        // Upload only the texels of the changed cells
+        for (int index : m_dirtyCells)
+        {
+            m_densityPixels[index] = densityColor(m_cellCounts[index]);
+
+            Rectangle texel = {
+                (float)(index % m_gridWidth),
+                (float)(index / m_gridWidth),
+                1, 1
+            };
+            UpdateTextureRec(m_densityTexture, texel, &m_densityPixels[index]);
+        }
+    }
+
+    rebuildCache();
+}
+
+void Minimap::render(const GameCamera& camera, Vector2 playerPosition) const
+{
+    // Render textures are stored upside down, flip the source rectangle
+    Rectangle source = { 0, 0, (float)m_cache.texture.width, -(float)m_cache.texture.height };
+    DrawTextureRec(m_cache.texture, source, { m_screenRect.x, m_screenRect.y }, WHITE);
+
+    // Calculate scaling factor
+    float scaleX = m_screenRect.width / m_worldSize.x;
+    float scaleY = m_screenRect.height / m_worldSize.y;
+
+    // Draw frustum on minimap
+    Rectangle frustum = camera.getFrustum();
+    Rectangle miniFrustum = {
+        m_screenRect.x + frustum.x * scaleX,
+        m_screenRect.y + frustum.y * scaleY,
+        frustum.width * scaleX,
+        frustum.height * scaleY
+    };
+    DrawRectangleLinesEx(miniFrustum, 1, GREEN);
+
+    // Draw player on minimap
+    DrawCircleV({ m_screenRect.x + playerPosition.x * scaleX, m_screenRect.y + playerPosition.y * scaleY }, 2.0f, RED);
+}
+
+Color Minimap::densityColor(int count) const
+{
+    float density = std::min(1.0f, (float)count / (float)m_maxCount);
+    return Fade(SKYBLUE, 0.1f + 0.8f * density);
+}
+
+void Minimap::rebuildCache()
+{
+    float width = m_screenRect.width;
+    float height = m_screenRect.height;
+
+    BeginTextureMode(m_cache);
+    ClearBackground(Fade(BLACK, 0.5f));
+
+    // Density, one texel stretched over each cell
+    Rectangle source = { 0, 0, (float)m_gridWidth, (float)m_gridHeight };
+    DrawTexturePro(m_densityTexture, source, { 0, 0, width, height }, { 0, 0 }, 0.0f, WHITE);
+
+    // Draw grid
+    for (int x = 0; x <= m_gridWidth; x++)
+    {
+        int lineX = (int)(x * width / m_gridWidth);
+        DrawLine(lineX, 0, lineX, (int)height, DARKGRAY);
+    }
+
+    for (int y = 0; y <= m_gridHeight; y++)
+    {
+        int lineY = (int)(y * height / m_gridHeight);
+        DrawLine(0, lineY, (int)width, lineY, DARKGRAY);
+    }
+
+    EndTextureMode();
+}
\ No newline at end of file
@@ -0,0 +1,307 @@
+// net_protocol.cpp
+
+#include "net_protocol.hpp"
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace
+{
+    using NetProtocol::MessageType;
+
+    const float QUANTIZATION_STEPS = 65535.0f;
+
+    void putU8(std::vector<unsigned char>& message, unsigned char value)
+    {
+        message.push_back(value);
+    }
+
+    void putU16(std::vector<unsigned char>& message, uint16_t value)
+    {
+        message.push_back((unsigned char)value);
+        message.push_back((unsigned char)(value >> 8));
+    }
+
+    void putF32(std::vector<unsigned char>& message, float value)
+    {
+        uint32_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        putU16(message, (uint16_t)bits);
+        putU16(message, (uint16_t)(bits >> 16));
+    }
+
+    // 7 bits per byte, small values take one byte
+    void putVarint(std::vector<unsigned char>& message, uint32_t value)
+    {
+        while (value >= 0x80)
+        {
+            message.push_back((unsigned char)(value | 0x80));
+            value >>= 7;
+        }
+        message.push_back((unsigned char)value);
+    }
+
+    uint16_t quantize(float value, float range)
+    {
+        float steps = std::round(value / range * QUANTIZATION_STEPS);
+        return (uint16_t)std::fmax(0.0f, std::fmin(QUANTIZATION_STEPS, steps));
+    }
+
+    float dequantize(uint16_t value, float range)
+    {
+        return value * range / QUANTIZATION_STEPS;
+    }
+
+    // Reads a message front to back, every read after the end fails
+    class MessageReader
+    {
+    public:
+        explicit MessageReader(const std::vector<unsigned char>& message) : m_message(message) {}
+
+        bool ok() const { return m_ok; }
+        bool atEnd() const { return m_position == m_message.size(); }
+
+        unsigned char u8()
+        {
+            if (m_position >= m_message.size())
+            {
+                m_ok = false;
+                return 0;
+            }
+            return m_message[m_position++];
+        }
+
+        uint16_t u16()
+        {
+            uint16_t low = u8();
+            return (uint16_t)(low | (u8() << 8));
+        }
+
+        float f32()
+        {
+            uint32_t low = u16();
+            uint32_t bits = low | ((uint32_t)u16() << 16);
+            float value;
+            memcpy(&value, &bits, sizeof(value));
+            return value;
+        }
+
+        uint32_t varint()
+        {
+            uint32_t value = 0;
+            for (int shift = 0; shift < 35; shift += 7)
+            {
+                unsigned char byte = u8();
+                value |= (uint32_t)(byte & 0x7f) << shift;
+                if ((byte & 0x80) == 0) return value;
+            }
+            m_ok = false;
+            return 0;
+        }
+
+        bool expect(MessageType type)
+        {
+            return u8() == (unsigned char)type && m_ok;
+        }
+
+    private:
+        const std::vector<unsigned char>& m_message;
+        size_t m_position = 0;
+        bool m_ok = true;
+    };
+}
+
+namespace NetProtocol
+{
+    MessageType getType(const std::vector<unsigned char>& message)
+    {
+        if (message.empty() || message[0] > (unsigned char)MessageType::Snapshot) return MessageType::Invalid;
+        return (MessageType)message[0];
+    }
+
+    void writeHello(std::vector<unsigned char>& message, Vector2 viewportSize)
+    {
+        message.clear();
+        putU8(message, (unsigned char)MessageType::Hello);
+        putF32(message, viewportSize.x);
+        putF32(message, viewportSize.y);
+    }
+
+    bool readHello(const std::vector<unsigned char>& message, Vector2& viewportSize)
+    {
+        MessageReader reader(message);
+        if (!reader.expect(MessageType::Hello)) return false;
+        viewportSize.x = reader.f32();
+        viewportSize.y = reader.f32();
+        return reader.ok() && viewportSize.x > 0 && viewportSize.y > 0;
+    }
+
+    void writeWelcome(std::vector<unsigned char>& message, Vector2 worldSize, Vector2 playerPosition,
+                      const std::vector<int>& cellCounts)
+    {
+        message.clear();
+        putU8(message, (unsigned char)MessageType::Welcome);
+        putF32(message, worldSize.x);
+        putF32(message, worldSize.y);
+        putF32(message, playerPosition.x);
+        putF32(message, playerPosition.y);
+
+        putVarint(message, (uint32_t)cellCounts.size());
+        for (int count : cellCounts)
+        {
+            putVarint(message, (uint32_t)count);
+        }
+    }
+
+    bool readWelcome(const std::vector<unsigned char>& message, Vector2& worldSize, Vector2& playerPosition,
+                     std::vector<int>& cellCounts)
+    {
+        MessageReader reader(message);
+        if (!reader.expect(MessageType::Welcome)) return false;
+        worldSize.x = reader.f32();
+        worldSize.y = reader.f32();
+        playerPosition.x = reader.f32();
+        playerPosition.y = reader.f32();
+
+        uint32_t cellCount = reader.varint();
+        if (!reader.ok() || cellCount > message.size()) return false;
+        cellCounts.resize(cellCount);
+        for (int& count : cellCounts)
+        {
+            count = (int)reader.varint();
+        }
+
+        return reader.ok() && worldSize.x > 0 && worldSize.y > 0;
+    }
+
+    void writeInput(std::vector<unsigned char>& message, unsigned char input)
+    {
+        message.clear();
+        putU8(message, (unsigned char)MessageType::Input);
+        putU8(message, input);
+    }
+
+    bool readInput(const std::vector<unsigned char>& message, unsigned char& input)
+    {
+        MessageReader reader(message);
+        if (!reader.expect(MessageType::Input)) return false;
+        input = reader.u8();
+        return reader.ok();
+    }
+
+    void writeSnapshot(std::vector<unsigned char>& message, const Snapshot& snapshot, Vector2 worldSize)
+    {
+        message.clear();
+        putU8(message, (unsigned char)MessageType::Snapshot);
+        putVarint(message, snapshot.tick);
+        putF32(message, snapshot.playerPosition.x);
+        putF32(message, snapshot.playerPosition.y);
+        putF32(message, snapshot.playerRotation);
+
+        putU8(message, snapshot.hasCamera ? 1 : 0);
+        if (snapshot.hasCamera)
+        {
+            putF32(message, snapshot.cameraPosition.x);
+            putF32(message, snapshot.cameraPosition.y);
+            putF32(message, snapshot.cameraFrame.x);
+            putF32(message, snapshot.cameraFrame.y);
+            putF32(message, snapshot.cameraFrame.width);
+            putF32(message, snapshot.cameraFrame.height);
+        }
+
+        // Sorted ids are sent as the difference to the previous one, mostly a single byte
+        putVarint(message, (uint32_t)snapshot.left.size());
+        unsigned int previous = 0;
+        for (unsigned int id : snapshot.left)
+        {
+            putVarint(message, id - previous);
+            previous = id;
+        }
+
+        // Rotation and its speed are sent exactly, so the client integrates the same values as the server
+        putVarint(message, (uint32_t)snapshot.entered.size());
+        previous = 0;
+        for (const auto& entered : snapshot.entered)
+        {
+            const Asteroid& asteroid = entered.asteroid;
+            putVarint(message, entered.id - previous);
+            previous = entered.id;
+
+            putU16(message, quantize(asteroid.position.x, worldSize.x));
+            putU16(message, quantize(asteroid.position.y, worldSize.y));
+            putU8(message, (unsigned char)asteroid.size.x);
+            putU8(message, (unsigned char)asteroid.size.y);
+            putF32(message, asteroid.rotation);
+            putF32(message, asteroid.rotationSpeed);
+            putU8(message, asteroid.color.r);
+            putU8(message, asteroid.color.g);
+            putU8(message, asteroid.color.b);
+            putU8(message, asteroid.color.a);
+            putU8(message, asteroid.layer);
+            putU8(message, asteroid.shapeId);
+        }
+    }
+
+    bool readSnapshot(const std::vector<unsigned char>& message, Snapshot& snapshot, Vector2 worldSize)
+    {
+        MessageReader reader(message);
+        if (!reader.expect(MessageType::Snapshot)) return false;
+
+        snapshot.tick = reader.varint();
+        snapshot.playerPosition.x = reader.f32();
+        snapshot.playerPosition.y = reader.f32();
+        snapshot.playerRotation = reader.f32();
+
+        snapshot.hasCamera = reader.u8() != 0;
+        if (snapshot.hasCamera)
+        {
+            snapshot.cameraPosition.x = reader.f32();
+            snapshot.cameraPosition.y = reader.f32();
+            snapshot.cameraFrame.x = reader.f32();
+            snapshot.cameraFrame.y = reader.f32();
+            snapshot.cameraFrame.width = reader.f32();
+            snapshot.cameraFrame.height = reader.f32();
+        }
+
+        // Counts are checked against the bytes left so a corrupt message cannot allocate much
+        uint32_t leftCount = reader.varint();
+        if (!reader.ok() || leftCount > message.size()) return false;
+        snapshot.left.resize(leftCount);
+        unsigned int previous = 0;
+        for (auto& id : snapshot.left)
+        {
+            id = previous + reader.varint();
+            previous = id;
+        }
+
+        uint32_t enteredCount = reader.varint();
+        if (!reader.ok() || enteredCount > message.size()) return false;
+        snapshot.entered.resize(enteredCount);
+        previous = 0;
+        for (auto& entered : snapshot.entered)
+        {
+            entered.id = previous + reader.varint();
+            previous = entered.id;
+
+            Vector2 position;
+            position.x = dequantize(reader.u16(), worldSize.x);
+            position.y = dequantize(reader.u16(), worldSize.y);
+            Vector2 size;
+            size.x = (float)reader.u8();
+            size.y = (float)reader.u8();
+            float rotation = reader.f32();
+            float rotationSpeed = reader.f32();
+            Color color;
+            color.r = reader.u8();
+            color.g = reader.u8();
+            color.b = reader.u8();
+            color.a = reader.u8();
+            int layer = reader.u8();
+            unsigned char shapeId = reader.u8();
+
+            entered.asteroid.initialize(position, size, rotation, rotationSpeed, color, layer, shapeId);
+        }
+
+        return reader.ok() && reader.atEnd();
+    }
+}
\ No newline at end of file
@@ -0,0 +1,279 @@
+// net_socket.cpp
+
+#include "net_socket.hpp"
+#include <cstring>
+#include <iostream>
+#include <utility>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <winsock2.h>
+#include <ws2tcpip.h>
+typedef int SocketLength;
+#define CLOSE_SOCKET closesocket
+#define WOULD_BLOCK (WSAGetLastError() == WSAEWOULDBLOCK)
+#define SEND_FLAGS 0
+#else
+#include <arpa/inet.h>
+#include <cerrno>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+typedef int SOCKET;
+typedef socklen_t SocketLength;
+#define CLOSE_SOCKET ::close
+#define WOULD_BLOCK (errno == EAGAIN || errno == EWOULDBLOCK)
+#define SEND_FLAGS MSG_NOSIGNAL     // A closed peer is reported as an error instead of SIGPIPE
+#endif
+
+namespace
+{
+    SOCKET toSocket(intptr_t handle)
+    {
+        return (SOCKET)handle;
+    }
+
+    // Snapshots are small and sent once per tick, do not wait to coalesce them
+    void disableNagle(SOCKET socket)
+    {
+        int flag = 1;
+        setsockopt(socket, IPPROTO_TCP, TCP_NODELAY, (const char*)&flag, sizeof(flag));
+    }
+}
+
+TcpSocket::~TcpSocket()
+{
+    close();
+}
+
+TcpSocket::TcpSocket(TcpSocket&& other) noexcept
+{
+    *this = std::move(other);
+}
+
+TcpSocket& TcpSocket::operator=(TcpSocket&& other) noexcept
+{
+    if (this != &other)
+    {
+        close();
+        m_handle = other.m_handle;
+        m_receiveBuffer.swap(other.m_receiveBuffer);
+        m_sendBuffer.swap(other.m_sendBuffer);
+        m_bytesSent = other.m_bytesSent;
+        m_bytesReceived = other.m_bytesReceived;
+        other.m_handle = INVALID;
+    }
+    return *this;
+}
+
+bool TcpSocket::startup()
+{
+#ifdef _WIN32
+    WSADATA data;
+    if (WSAStartup(MAKEWORD(2, 2), &data) != 0)
+    {
+        std::cerr << "Failed to initialize Winsock" << std::endl;
+        return false;
+    }
+#endif
+    return true;
+}
+
+void TcpSocket::cleanup()
+{
+#ifdef _WIN32
+    WSACleanup();
+#endif
+}
+
+bool TcpSocket::listen(int port)
+{
+    close();
+
+    SOCKET handle = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    m_handle = (intptr_t)handle;
+    if (!isOpen())
+    {
+        std::cerr << "Failed to create server socket" << std::endl;
+        return false;
+    }
+
+    int reuse = 1;
+    setsockopt(handle, SOL_SOCKET, SO_REUSEADDR, (const char*)&reuse, sizeof(reuse));
+
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    address.sin_port = htons((unsigned short)port);
+
+    if (bind(handle, (const sockaddr*)&address, sizeof(address)) != 0 || ::listen(handle, 8) != 0)
+    {
+        std::cerr << "Failed to listen on port " << port << std::endl;
+        close();
+        return false;
+    }
+
+    return setNonBlocking();
+}
+
+bool TcpSocket::connect(const std::string& host, int port)
+{
+    close();
+
+    addrinfo hints = {};
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_protocol = IPPROTO_TCP;
+
+    addrinfo* result = nullptr;
+    std::string service = std::to_string(port);
+    if (getaddrinfo(host.c_str(), service.c_str(), &hints, &result) != 0 || result == nullptr)
+    {
+        std::cerr << "Failed to resolve " << host << std::endl;
+        return false;
+    }
+
+    SOCKET handle = socket(result->ai_family, result->ai_socktype, result->ai_protocol);
+    m_handle = (intptr_t)handle;
+    bool connected = isOpen() && ::connect(handle, result->ai_addr, (SocketLength)result->ai_addrlen) == 0;
+    freeaddrinfo(result);
+
+    if (!connected)
+    {
+        std::cerr << "Failed to connect to " << host << ":" << port << std::endl;
+        close();
+        return false;
+    }
+
+    disableNagle(handle);
+    return setNonBlocking();
+}
+
+bool TcpSocket::accept(TcpSocket& client)
+{
+    if (!isOpen()) return false;
+
+    SOCKET handle = ::accept(toSocket(m_handle), nullptr, nullptr);
+    if ((intptr_t)handle == INVALID) return false;
+
+    client.close();
+    client.m_handle = (intptr_t)handle;
+    disableNagle(handle);
+    return client.setNonBlocking();
+}
+
+bool TcpSocket::sendMessage(const std::vector<unsigned char>& message)
+{
+    if (!isOpen()) return false;
+
+    // A peer that stopped reading must not make the queue grow without bound
+    if (m_sendBuffer.size() + 4 + message.size() > MAX_SEND_BACKLOG)
+    {
+        std::cerr << "Dropping connection with " << m_sendBuffer.size() << " bytes unsent" << std::endl;
+        close();
+        return false;
+    }
+
+    // Length prefix in little endian, then the payload
+    uint32_t length = (uint32_t)message.size();
+    unsigned char header[4] = {
+        (unsigned char)length, (unsigned char)(length >> 8),
+        (unsigned char)(length >> 16), (unsigned char)(length >> 24)
+    };
+    m_sendBuffer.insert(m_sendBuffer.end(), header, header + sizeof(header));
+    m_sendBuffer.insert(m_sendBuffer.end(), message.begin(), message.end());
+
+    return flush();
+}
+
+bool TcpSocket::flush()
+{
+    size_t sent = 0;
+    while (isOpen() && sent < m_sendBuffer.size())
+    {
+        int result = send(toSocket(m_handle), (const char*)m_sendBuffer.data() + sent, (int)(m_sendBuffer.size() - sent), SEND_FLAGS);
+        if (result > 0)
+        {
+            sent += (size_t)result;
+            continue;
+        }
+
+        // The OS buffer is full, the rest stays queued for the next flush
+        if (result < 0 && WOULD_BLOCK) break;
+
+        // Closing also drops the queue
+        close();
+        return false;
+    }
+
+    m_sendBuffer.erase(m_sendBuffer.begin(), m_sendBuffer.begin() + sent);
+    m_bytesSent += sent;
+    return isOpen();
+}
+
+bool TcpSocket::receiveMessage(std::vector<unsigned char>& message)
+{
+    // Drain what has arrived
+    while (isOpen())
+    {
+        unsigned char buffer[4096];
+        int result = recv(toSocket(m_handle), (char*)buffer, sizeof(buffer), 0);
+        if (result > 0)
+        {
+            m_receiveBuffer.insert(m_receiveBuffer.end(), buffer, buffer + result);
+            m_bytesReceived += (uint64_t)result;
+            continue;
+        }
+
+        // Zero is an orderly shutdown by the peer
+        if (result < 0 && WOULD_BLOCK) break;
+        close();
+    }
+
+    if (m_receiveBuffer.size() < 4) return false;
+
+    uint32_t length = (uint32_t)m_receiveBuffer[0] | ((uint32_t)m_receiveBuffer[1] << 8)
+        | ((uint32_t)m_receiveBuffer[2] << 16) | ((uint32_t)m_receiveBuffer[3] << 24);
+    if (length > MAX_MESSAGE_SIZE)
+    {
+        std::cerr << "Dropping connection after an oversized message" << std::endl;
+        close();
+        m_receiveBuffer.clear();
+        return false;
+    }
+
+    if (m_receiveBuffer.size() < 4 + length) return false;
+
+    message.assign(m_receiveBuffer.begin() + 4, m_receiveBuffer.begin() + 4 + length);
+    m_receiveBuffer.erase(m_receiveBuffer.begin(), m_receiveBuffer.begin() + 4 + length);
+    return true;
+}
+
+void TcpSocket::close()
+{
+    if (!isOpen()) return;
+
+    CLOSE_SOCKET(toSocket(m_handle));
+    m_handle = INVALID;
+    m_sendBuffer.clear();
+}
+
+bool TcpSocket::setNonBlocking()
+{
+#ifdef _WIN32
+    u_long enabled = 1;
+    bool success = ioctlsocket(toSocket(m_handle), FIONBIO, &enabled) == 0;
+#else
+    int flags = fcntl(toSocket(m_handle), F_GETFL, 0);
+    bool success = flags >= 0 && fcntl(toSocket(m_handle), F_SETFL, flags | O_NONBLOCK) == 0;
+#endif
+    if (!success)
+    {
+        std::cerr << "Failed to make socket non-blocking" << std::endl;
+        close();
+    }
+    return success;
+}
\ No newline at end of file
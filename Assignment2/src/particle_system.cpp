@@ -0,0 +1,134 @@
+// particle_system.cpp
+
+#include "particle_system.hpp"
+#include "math_utils.hpp"
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define PARTICLE_SYSTEM_SSE2 1
+#endif
+
+void ParticleSystem::initialize(int capacity)
+{
+    m_capacity = capacity;
+    m_limit = capacity;
+    m_count = 0;
+    m_dropped = 0;
+
+    // Rounded up to a multiple of 4 so the vector loop can run past the last live particle
+    size_t padded = (size_t)((capacity + 3) & ~3);
+    m_positionX.assign(padded, 0.0f);
+    m_positionY.assign(padded, 0.0f);
+    m_velocityX.assign(padded, 0.0f);
+    m_velocityY.assign(padded, 0.0f);
+    m_life.assign(padded, 0.0f);
+    m_inverseLifetime.assign(padded, 0.0f);
+    m_size.assign(padded, 0.0f);
+    m_colors.assign(padded, BLANK);
+}
+
+void ParticleSystem::emit(Vector2 position, Vector2 velocity, float spread, int count,
+                          Color color, float lifetime, float size)
+{
+    // Scale the request down linearly between 3/4 and all of the limit
+    int softLimit = m_limit * 3 / 4;
+    int granted = count;
+    if (m_count > softLimit)
+    {
+        granted = count * std::max(0, m_limit - m_count) / std::max(1, m_limit - softLimit);
+    }
+    granted = std::clamp(granted, 0, std::max(0, m_limit - m_count));
+    m_dropped += count - granted;
+
+    for (int n = 0; n < granted; n++)
+    {
+        int i = m_count++;
+        m_positionX[i] = position.x;
+        m_positionY[i] = position.y;
+        m_velocityX[i] = velocity.x + MathUtils::random(-spread, spread);
+        m_velocityY[i] = velocity.y + MathUtils::random(-spread, spread);
+
+        // Some variation so a burst does not expire in a single frame
+        float life = lifetime * MathUtils::random(0.6f, 1.0f);
+        m_life[i] = life;
+        m_inverseLifetime[i] = 1.0f / life;
+        m_size[i] = size;
+        m_colors[i] = color;
+    }
+}
+
+void ParticleSystem::setLimit(int limit)
+{
+    m_limit = std::clamp(limit, 0, m_capacity);
+}
+
+void ParticleSystem::update(float deltaTime)
+{
+    integrate(deltaTime);
+    removeExpired();
+}
+
+Color ParticleSystem::getColor(int i) const
+{
+    Color color = m_colors[i];
+    float remaining = std::clamp(m_life[i] * m_inverseLifetime[i], 0.0f, 1.0f);
+    color.a = (unsigned char)(color.a * remaining);
+    return color;
+}
+
+void ParticleSystem::integrate(float deltaTime)
+{
+    float damping = std::max(0.0f, 1.0f - DRAG * deltaTime);
+    int end = (m_count + 3) & ~3;
+
+#ifdef PARTICLE_SYSTEM_SSE2
+    const __m128 dt = _mm_set1_ps(deltaTime);
+    const __m128 damp = _mm_set1_ps(damping);
+
+    for (int i = 0; i < end; i += 4)
+    {
+        __m128 vx = _mm_loadu_ps(&m_velocityX[i]);
+        __m128 vy = _mm_loadu_ps(&m_velocityY[i]);
+
+        _mm_storeu_ps(&m_positionX[i], _mm_add_ps(_mm_loadu_ps(&m_positionX[i]), _mm_mul_ps(vx, dt)));
+        _mm_storeu_ps(&m_positionY[i], _mm_add_ps(_mm_loadu_ps(&m_positionY[i]), _mm_mul_ps(vy, dt)));
+        _mm_storeu_ps(&m_velocityX[i], _mm_mul_ps(vx, damp));
+        _mm_storeu_ps(&m_velocityY[i], _mm_mul_ps(vy, damp));
+        _mm_storeu_ps(&m_life[i], _mm_sub_ps(_mm_loadu_ps(&m_life[i]), dt));
+    }
+#else
+    for (int i = 0; i < end; i++)
+    {
+        m_positionX[i] += m_velocityX[i] * deltaTime;
+        m_positionY[i] += m_velocityY[i] * deltaTime;
+        m_velocityX[i] *= damping;
+        m_velocityY[i] *= damping;
+        m_life[i] -= deltaTime;
+    }
+#endif
+}
+
+void ParticleSystem::removeExpired()
+{
+    // Move the last live particle into each expired slot, the order of particles does not matter
+    int i = 0;
+    while (i < m_count)
+    {
+        if (m_life[i] > 0.0f)
+        {
+            i++;
+            continue;
+        }
+
+        int last = --m_count;
+        m_positionX[i] = m_positionX[last];
+        m_positionY[i] = m_positionY[last];
+        m_velocityX[i] = m_velocityX[last];
+        m_velocityY[i] = m_velocityY[last];
+        m_life[i] = m_life[last];
+        m_inverseLifetime[i] = m_inverseLifetime[last];
+        m_size[i] = m_size[last];
+        m_colors[i] = m_colors[last];
+    }
+}
\ No newline at end of file
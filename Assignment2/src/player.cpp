@@ -40,18 +40,24 @@ void Player::update()
     if (m_position.y + m_cameraFrame.height > m_worldSize.y) m_position.y = m_worldSize.y - m_cameraFrame.height;
 }
 
+bool Player::isAtBoundary() const
+{
+    return m_position.x <= m_cameraFrame.width || m_position.y <= m_cameraFrame.height ||
+        m_position.x >= m_worldSize.x - m_cameraFrame.width || m_position.y >= m_worldSize.y - m_cameraFrame.height;
+}
+
 void Player::applyThrust()
 {
     m_velocity.x += cosf(m_rotation) * THRUST_FORCE;
     m_velocity.y += sinf(m_rotation) * THRUST_FORCE;
 }
 
-void Player::rotateLeft()
+void Player::rotateLeft(float deltaTime)
 {
-    m_rotation -= ROTATION_SPEED * GetFrameTime();
+    m_rotation -= ROTATION_SPEED * deltaTime;
 }
 
-void Player::rotateRight()
+void Player::rotateRight(float deltaTime)
 {
-    m_rotation += ROTATION_SPEED * GetFrameTime();
+    m_rotation += ROTATION_SPEED * deltaTime;
 }
\ No newline at end of file
@@ -0,0 +1,115 @@
+// quality_governor.cpp
+
+#include "quality_governor.hpp"
+#include <raylib.h>
+#include <algorithm>
+#include <iostream>
+
+namespace
+{
+    // Level 0 is the full quality, each further level sheds more background detail
+    const QualitySettings LEVELS[] = {
+        { 1.00f,  0.0f, 1.00f, true },
+        { 0.50f,  0.0f, 1.00f, true },
+        { 0.50f, 12.0f, 1.00f, false },
+        { 0.25f, 12.0f, 0.50f, false },
+        { 0.25f, 24.0f, 0.25f, false }
+    };
+
+    const int LEVEL_COUNT = (int)(sizeof(LEVELS) / sizeof(LEVELS[0]));
+
+    const char* STAGE_NAMES[] = { "simulation", "culling", "render" };
+}
+
+void QualityGovernor::initialize(double budgetMilliseconds)
+{
+    m_budget = std::max(0.0, budgetMilliseconds) / 1000.0;
+    m_level = 0;
+    m_overBudgetFrames = 0;
+    m_underBudgetFrames = 0;
+    std::fill(std::begin(m_stageTimes), std::end(m_stageTimes), 0.0);
+
+    if (isEnabled()) std::cout << "Quality governor: " << budgetMilliseconds << " ms frame budget" << std::endl;
+    else std::cout << "Quality governor off, rendering at full quality" << std::endl;
+}
+
+void QualityGovernor::beginFrame()
+{
+    m_stageStart = GetTime();
+    std::fill(std::begin(m_frameStages), std::end(m_frameStages), 0.0);
+}
+
+void QualityGovernor::endStage(FrameStage stage)
+{
+    double now = GetTime();
+    m_frameStages[(int)stage] += now - m_stageStart;
+    m_stageStart = now;
+}
+
+bool QualityGovernor::endFrame()
+{
+    for (int i = 0; i < (int)FrameStage::Count; i++)
+    {
+        m_stageTimes[i] += (m_frameStages[i] - m_stageTimes[i]) * SMOOTHING;
+    }
+
+    if (!isEnabled()) return false;
+
+    double frameTime = getFrameTime() / 1000.0;
+    m_overBudgetFrames = frameTime > m_budget ? m_overBudgetFrames + 1 : 0;
+    m_underBudgetFrames = frameTime < m_budget * RECOVER_RATIO ? m_underBudgetFrames + 1 : 0;
+
+    if (m_overBudgetFrames >= DEGRADE_FRAMES && m_level < LEVEL_COUNT - 1)
+    {
+        changeLevel(m_level + 1, "over");
+        return true;
+    }
+
+    if (m_underBudgetFrames >= RECOVER_FRAMES && m_level > 0)
+    {
+        changeLevel(m_level - 1, "under");
+        return true;
+    }
+
+    return false;
+}
+
+int QualityGovernor::getLevelCount()
+{
+    return LEVEL_COUNT;
+}
+
+const QualitySettings& QualityGovernor::getSettings() const
+{
+    return LEVELS[m_level];
+}
+
+double QualityGovernor::getFrameTime() const
+{
+    double total = 0.0;
+    for (double time : m_stageTimes) total += time;
+    return total * 1000.0;
+}
+
+void QualityGovernor::changeLevel(int level, const char* reason)
+{
+    // Log the measurement behind the decision together with the new settings
+    std::cout << "Quality level " << m_level << " -> " << level << ": "
+        << getFrameTime() << " ms " << reason << " the " << getBudget() << " ms budget (";
+    for (int i = 0; i < (int)FrameStage::Count; i++)
+    {
+        std::cout << (i > 0 ? ", " : "") << STAGE_NAMES[i] << " " << getStageTime((FrameStage)i) << " ms";
+    }
+
+    const QualitySettings& settings = LEVELS[level];
+    std::cout << "), stars " << settings.starDensity * 100.0f << "%";
+    if (settings.lodThreshold > 0.0f) std::cout << ", asteroid LOD below " << settings.lodThreshold << " px";
+    else std::cout << ", asteroid LOD off";
+    std::cout << ", particles " << settings.particleLimit * 100.0f << "%"
+        << ", overlay " << (settings.detailedOverlay ? "detailed" : "text only") << std::endl;
+
+    // Start counting again, the new level has to prove itself
+    m_level = level;
+    m_overBudgetFrames = 0;
+    m_underBudgetFrames = 0;
+}
\ No newline at end of file
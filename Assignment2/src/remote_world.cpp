@@ -0,0 +1,106 @@
+// remote_world.cpp
+
+#include "remote_world.hpp"
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+bool RemoteWorld::connect(const std::string& host, int port, Vector2 viewportSize)
+{
+    if (!m_socket.connect(host, port)) return false;
+
+    NetProtocol::writeHello(m_message, viewportSize);
+    if (!m_socket.sendMessage(m_message)) return false;
+
+    // The server answers at its next tick
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (std::chrono::steady_clock::now() < deadline && m_socket.flush())
+    {
+        if (!m_socket.receiveMessage(m_message))
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            continue;
+        }
+
+        if (!NetProtocol::readWelcome(m_message, m_worldSize, m_playerPosition, m_cellCounts)) break;
+
+        m_ids.clear();
+        m_asteroids.clear();
+        m_snapshotCount = 0;
+        std::cout << "Connected to " << host << ":" << port << std::endl;
+        return true;
+    }
+
+    std::cerr << "No welcome from " << host << ":" << port << std::endl;
+    m_socket.close();
+    return false;
+}
+
+void RemoteWorld::disconnect()
+{
+    m_socket.close();
+}
+
+void RemoteWorld::sendInput(unsigned char input)
+{
+    NetProtocol::writeInput(m_message, input);
+    m_socket.sendMessage(m_message);
+}
+
+bool RemoteWorld::applyNextSnapshot()
+{
+    if (!m_socket.receiveMessage(m_message)) return false;
+
+    if (!NetProtocol::readSnapshot(m_message, m_snapshot, m_worldSize))
+    {
+        std::cerr << "Invalid snapshot, disconnecting" << std::endl;
+        m_socket.close();
+        return false;
+    }
+
+    applySnapshot(m_snapshot);
+    return true;
+}
+
+void RemoteWorld::applySnapshot(const NetProtocol::Snapshot& snapshot)
+{
+    // Ticks since the previous snapshot, more than one if the server coalesced snapshots
+    unsigned int ticks = m_snapshotCount > 0 ? snapshot.tick - m_tick : 0;
+    m_tick = snapshot.tick;
+    m_playerPosition = snapshot.playerPosition;
+    m_playerRotation = snapshot.playerRotation;
+    m_snapshotCount++;
+
+    // The server rotated every asteroid once per tick, kept ones are rotated here the same way
+    for (auto& asteroid : m_asteroids)
+    {
+        for (unsigned int i = 0; i < ticks; i++) asteroid.update();
+    }
+
+    // Merge the sorted lists: drop the ids that left, insert the ones that entered
+    m_mergedIds.clear();
+    m_mergedAsteroids.clear();
+    size_t left = 0, entered = 0;
+    for (size_t i = 0; i <= m_ids.size(); i++)
+    {
+        unsigned int id = i < m_ids.size() ? m_ids[i] : 0xffffffffu;
+
+        while (entered < snapshot.entered.size() && snapshot.entered[entered].id < id)
+        {
+            m_mergedIds.push_back(snapshot.entered[entered].id);
+            m_mergedAsteroids.push_back(snapshot.entered[entered].asteroid);
+            entered++;
+        }
+
+        if (i == m_ids.size()) break;
+
+        while (left < snapshot.left.size() && snapshot.left[left] < id) left++;
+        if (left < snapshot.left.size() && snapshot.left[left] == id) continue;
+
+        m_mergedIds.push_back(id);
+        m_mergedAsteroids.push_back(m_asteroids[i]);
+    }
+
+    m_ids.swap(m_mergedIds);
+    m_asteroids.swap(m_mergedAsteroids);
+}
\ No newline at end of file
@@ -0,0 +1,414 @@
+// render_batch.cpp
+
+#include "render_batch.hpp"
+#include "math_utils.hpp"
+#include <raylib.h>
+#include <rlgl.h>
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define RENDER_BATCH_SSE2 1
+#endif
+
+void RenderBatch::build(const RenderCommandList& commands, const GameCamera& camera, const SpriteAtlas& atlas)
+{
+    m_atlas = &atlas;
+    m_texture = atlas.getTexture();
+
+    // Obtain camera information
+    Vector2 cameraPos = camera.getPosition();
+    Vector2 viewportSize = camera.getViewportSize();
+    Rectangle cameraFrame = camera.getCameraFrame();
+
+    // World to screen is a scale plus an offset, shared by every polygon
+    Vector2 scale = {
+        cameraFrame.width / viewportSize.x,
+        cameraFrame.height / viewportSize.y
+    };
+    Vector2 offset = {
+        cameraFrame.x + (viewportSize.x / 2 - cameraPos.x) * scale.x,
+        cameraFrame.y + (viewportSize.y / 2 - cameraPos.y) * scale.y
+    };
+    m_cameraFrame = cameraFrame;
+    m_scale = scale;
+    m_offset = offset;
+
+    // Round up to a multiple of 4 so the vector loop needs no scalar tail
+    resize((commands.size() + 3) & ~static_cast<size_t>(3));
+    m_opaquePolygons.clear();
+    m_translucentPolygons.clear();
+    m_particleX.clear();
+    m_particleY.clear();
+    m_particleHalfSize.clear();
+    m_particleColors.clear();
+    m_sprites.clear();
+    m_triangles.clear();
+    m_coveredArea = 0.0f;
+    m_reducedPolygonCount = 0;
+
+    // Gather pass: copy world data out of the command array and look up sin/cos
+    size_t count = 0;
+    for (const auto& cmd : commands)
+    {
+        if (cmd.type == RenderCommandType::Player) continue;
+
+        m_centerX[count] = cmd.position.x;
+        m_centerY[count] = cmd.position.y;
+        m_halfWidth[count] = cmd.size.x / 2;
+        m_halfHeight[count] = cmd.size.y / 2;
+        m_colors[count] = cmd.color;
+        m_depth[count] = layerDepth(cmd.layer);
+        m_regions[count] = atlas.getRegion(cmd.sprite);
+        m_shapes[count] = cmd.shapeId;
+        m_coveredArea += AsteroidShapes::get(cmd.shapeId).area * m_halfWidth[count] * scale.x * m_halfHeight[count] * scale.y;
+        if (std::max(m_halfWidth[count] * scale.x, m_halfHeight[count] * scale.y) < m_lodThreshold) m_reducedPolygonCount++;
+
+        if (cmd.rotation == 0.0f)
+        {
+            m_sin[count] = 0.0f;
+            m_cos[count] = 1.0f;
+        }
+        else
+        {
+            MathUtils::fastSinCos(cmd.rotation * DEG2RAD, m_sin[count], m_cos[count]);
+        }
+
+        if (cmd.color.a == 255 && atlas.isOpaque(cmd.sprite)) m_opaquePolygons.push_back((int)count);
+        else m_translucentPolygons.push_back((int)count);
+
+        count++;
+    }
+
+    // Opaque polygons are submitted nearest first
+    std::reverse(m_opaquePolygons.begin(), m_opaquePolygons.end());
+
+    // With equal depths every overlapping polygon of a layer would pass the test. Each opaque
+    // polygon gets a bias that shrinks in submission order, the first one is on top as it was
+    // when drawn last, and the bias stays below the next layer. Translucent polygons take the
+    // top of the range so they still pass over the opaque ones of their layer
+    float biasRange = LAYER_BIAS_RANGE * (layerDepth(1) - layerDepth(0));
+    float opaqueCount = (float)m_opaquePolygons.size();
+    for (size_t j = 0; j < m_opaquePolygons.size(); j++)
+    {
+        m_depth[m_opaquePolygons[j]] += biasRange * (opaqueCount - (float)j) / opaqueCount;
+    }
+    for (int i : m_translucentPolygons)
+    {
+        m_depth[i] += biasRange;
+    }
+
+    // Zero the padding so the vector loop only produces degenerate polygons there
+    size_t paddedCount = (count + 3) & ~static_cast<size_t>(3);
+    for (size_t i = count; i < paddedCount; i++)
+    {
+        m_centerX[i] = m_centerY[i] = 0.0f;
+        m_halfWidth[i] = m_halfHeight[i] = 0.0f;
+        m_sin[i] = 0.0f;
+        m_cos[i] = 1.0f;
+        m_shapes[i] = 0;
+    }
+
+    m_polygonCount = static_cast<int>(count);
+    transformVertices(0, paddedCount, scale, offset);
+}
+
+void RenderBatch::addSprite(Vector2 center, Vector2 size, float rotation, SpriteId sprite, Color color, int layer)
+{
+    float sine, cosine;
+    MathUtils::fastSinCos(rotation, sine, cosine);
+
+    // Same corner formulas as the polygon vertices, already in screen space
+    float a = size.x / 2 * cosine;
+    float b = size.y / 2 * sine;
+    float d = size.x / 2 * sine;
+    float e = size.y / 2 * cosine;
+
+    Sprite quad;
+    quad.corners[0] = { center.x - a + b, center.y - d - e };
+    quad.corners[1] = { center.x - a - b, center.y - d + e };
+    quad.corners[2] = { center.x + a - b, center.y + d + e };
+    quad.corners[3] = { center.x + a + b, center.y + d - e };
+    quad.region = m_atlas->getRegion(sprite);
+    quad.color = color;
+    quad.depth = layerDepth(layer);
+    quad.opaque = color.a == 255 && m_atlas->isOpaque(sprite);
+
+    m_sprites.push_back(quad);
+    m_coveredArea += size.x * size.y;
+}
+
+void RenderBatch::addParticles(const ParticleSystem& particles, int layer)
+{
+    m_particleDepth = layerDepth(layer);
+
+    for (int i = 0; i < particles.getCount(); i++)
+    {
+        float x = particles.getX(i) * m_scale.x + m_offset.x;
+        float y = particles.getY(i) * m_scale.y + m_offset.y;
+        float halfSize = particles.getSize(i) * m_scale.x / 2;
+
+        // The scissor clips the rest, culling here only keeps the vertex count down
+        if (x + halfSize < m_cameraFrame.x || x - halfSize > m_cameraFrame.x + m_cameraFrame.width ||
+            y + halfSize < m_cameraFrame.y || y - halfSize > m_cameraFrame.y + m_cameraFrame.height) continue;
+
+        m_particleX.push_back(x);
+        m_particleY.push_back(y);
+        m_particleHalfSize.push_back(halfSize);
+        m_particleColors.push_back(particles.getColor(i));
+        m_coveredArea += 4 * halfSize * halfSize;
+    }
+}
+
+void RenderBatch::addTriangle(Vector2 a, Vector2 b, Vector2 c, Color color, int layer)
+{
+    m_triangles.push_back({ { a, b, c }, color, layerDepth(layer) });
+    m_coveredArea += std::fabs((b.x - a.x) * (c.y - a.y) - (c.x - a.x) * (b.y - a.y)) / 2;
+}
+
+float RenderBatch::layerDepth(int layer)
+{
+    // The 2D projection keeps z in [-1, 0], raylib's own shapes are drawn near -1
+    layer = std::clamp(layer, 0, MAX_LAYER);
+    return -1.0f + (float)(layer + 1) / (MAX_LAYER + 2);
+}
+
+void RenderBatch::resize(size_t paddedCount)
+{
+    if (m_centerX.size() >= paddedCount) return;
+
+    m_centerX.resize(paddedCount);
+    m_centerY.resize(paddedCount);
+    m_halfWidth.resize(paddedCount);
+    m_halfHeight.resize(paddedCount);
+    m_sin.resize(paddedCount);
+    m_cos.resize(paddedCount);
+    m_depth.resize(paddedCount);
+    m_colors.resize(paddedCount);
+    m_regions.resize(paddedCount);
+    m_shapes.resize(paddedCount);
+    m_screenX.resize(paddedCount);
+    m_screenY.resize(paddedCount);
+
+    for (int vertex = 0; vertex < VERTEX_COUNT; vertex++)
+    {
+        m_vertexX[vertex].resize(paddedCount);
+        m_vertexY[vertex].resize(paddedCount);
+    }
+}
+
+void RenderBatch::transformVertices(size_t begin, size_t end, Vector2 scale, Vector2 offset)
+{
+    // A template vertex (x, y) of a polygon rotated around its center with half extents (hw, hh):
+    //   screen = (cx + x * hw * cos - y * hh * sin, cy + x * hw * sin + y * hh * cos)
+#ifdef RENDER_BATCH_SSE2
+    const __m128 scaleX = _mm_set1_ps(scale.x);
+    const __m128 scaleY = _mm_set1_ps(scale.y);
+    const __m128 offsetX = _mm_set1_ps(offset.x);
+    const __m128 offsetY = _mm_set1_ps(offset.y);
+
+    for (size_t i = begin; i < end; i += 4)
+    {
+        __m128 cx = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&m_centerX[i]), scaleX), offsetX);
+        __m128 cy = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&m_centerY[i]), scaleY), offsetY);
+        __m128 hw = _mm_mul_ps(_mm_loadu_ps(&m_halfWidth[i]), scaleX);
+        __m128 hh = _mm_mul_ps(_mm_loadu_ps(&m_halfHeight[i]), scaleY);
+        __m128 s = _mm_loadu_ps(&m_sin[i]);
+        __m128 c = _mm_loadu_ps(&m_cos[i]);
+
+        _mm_storeu_ps(&m_screenX[i], cx);
+        _mm_storeu_ps(&m_screenY[i], cy);
+
+        // The four polygons of a group may use different templates
+        const AsteroidShapes::Shape& shape0 = AsteroidShapes::get(m_shapes[i]);
+        const AsteroidShapes::Shape& shape1 = AsteroidShapes::get(m_shapes[i + 1]);
+        const AsteroidShapes::Shape& shape2 = AsteroidShapes::get(m_shapes[i + 2]);
+        const AsteroidShapes::Shape& shape3 = AsteroidShapes::get(m_shapes[i + 3]);
+
+        for (int k = 0; k < VERTEX_COUNT; k++)
+        {
+            __m128 x = _mm_mul_ps(hw, _mm_setr_ps(shape0.vertices[k].x, shape1.vertices[k].x,
+                                                   shape2.vertices[k].x, shape3.vertices[k].x));
+            __m128 y = _mm_mul_ps(hh, _mm_setr_ps(shape0.vertices[k].y, shape1.vertices[k].y,
+                                                   shape2.vertices[k].y, shape3.vertices[k].y));
+
+            _mm_storeu_ps(&m_vertexX[k][i], _mm_add_ps(cx, _mm_sub_ps(_mm_mul_ps(x, c), _mm_mul_ps(y, s))));
+            _mm_storeu_ps(&m_vertexY[k][i], _mm_add_ps(cy, _mm_add_ps(_mm_mul_ps(x, s), _mm_mul_ps(y, c))));
+        }
+    }
+#else
+    for (size_t i = begin; i < end; i++)
+    {
+        float cx = m_centerX[i] * scale.x + offset.x;
+        float cy = m_centerY[i] * scale.y + offset.y;
+        float hw = m_halfWidth[i] * scale.x;
+        float hh = m_halfHeight[i] * scale.y;
+
+        m_screenX[i] = cx;
+        m_screenY[i] = cy;
+
+        const AsteroidShapes::Shape& shape = AsteroidShapes::get(m_shapes[i]);
+        for (int k = 0; k < VERTEX_COUNT; k++)
+        {
+            float x = shape.vertices[k].x * hw;
+            float y = shape.vertices[k].y * hh;
+            m_vertexX[k][i] = cx + x * m_cos[i] - y * m_sin[i];
+            m_vertexY[k][i] = cy + x * m_sin[i] + y * m_cos[i];
+        }
+    }
+#endif
+}
+
+void RenderBatch::drawOpaque() const
+{
+    // One texture for the whole pass. Triangles and sprites (the player) are in the top layer, so they go first
+    rlSetTexture(m_texture.id);
+    drawTriangles(true);
+    drawSprites(true);
+    drawPolygons(m_opaquePolygons);
+    rlSetTexture(0);
+}
+
+void RenderBatch::drawTranslucent() const
+{
+    rlSetTexture(m_texture.id);
+    drawPolygons(m_translucentPolygons);
+    drawParticles();
+    drawSprites(false);
+    drawTriangles(false);
+    rlSetTexture(0);
+}
+
+void RenderBatch::drawPolygons(const std::vector<int>& polygons) const
+{
+    if (polygons.empty()) return;
+
+    // Fan of triangles around the center, the template is mapped onto the atlas region
+    rlBegin(RL_TRIANGLES);
+    rlNormal3f(0.0f, 0.0f, 1.0f);
+
+    for (int i : polygons)
+    {
+        Color color = outputColor(m_colors[i]);
+        float depth = m_depth[i];
+        const Rectangle& region = m_regions[i];
+        const AsteroidShapes::Shape& shape = AsteroidShapes::get(m_shapes[i]);
+        float centerU = region.x + region.width / 2;
+        float centerV = region.y + region.height / 2;
+        rlColor4ub(color.r, color.g, color.b, color.a);
+
+        // Small on screen: two triangles through every other vertex instead of the full fan
+        if (std::max(m_halfWidth[i] * m_scale.x, m_halfHeight[i] * m_scale.y) < m_lodThreshold)
+        {
+            for (int k = 2; k + 2 < VERTEX_COUNT; k += 2)
+            {
+                const int corners[3] = { 0, k + 2, k };
+                for (int corner : corners)
+                {
+                    rlTexCoord2f(centerU + shape.vertices[corner].x * region.width / 2, centerV + shape.vertices[corner].y * region.height / 2);
+                    rlVertex3f(m_vertexX[corner][i], m_vertexY[corner][i], depth);
+                }
+            }
+            continue;
+        }
+
+        for (int k = 0; k < VERTEX_COUNT; k++)
+        {
+            int next = (k + 1) % VERTEX_COUNT;
+
+            rlTexCoord2f(centerU, centerV);
+            rlVertex3f(m_screenX[i], m_screenY[i], depth);
+            rlTexCoord2f(centerU + shape.vertices[next].x * region.width / 2, centerV + shape.vertices[next].y * region.height / 2);
+            rlVertex3f(m_vertexX[next][i], m_vertexY[next][i], depth);
+            rlTexCoord2f(centerU + shape.vertices[k].x * region.width / 2, centerV + shape.vertices[k].y * region.height / 2);
+            rlVertex3f(m_vertexX[k][i], m_vertexY[k][i], depth);
+        }
+    }
+
+    rlEnd();
+}
+
+void RenderBatch::drawParticles() const
+{
+    if (m_particleX.empty()) return;
+
+    Rectangle white = m_atlas->getRegion(SpriteId::White);
+    float u = white.x + white.width / 2;
+    float v = white.y + white.height / 2;
+
+    rlBegin(RL_QUADS);
+    rlNormal3f(0.0f, 0.0f, 1.0f);
+    rlTexCoord2f(u, v);
+
+    for (size_t i = 0; i < m_particleX.size(); i++)
+    {
+        Color color = outputColor(m_particleColors[i]);
+        float x = m_particleX[i];
+        float y = m_particleY[i];
+        float h = m_particleHalfSize[i];
+        rlColor4ub(color.r, color.g, color.b, color.a);
+
+        rlVertex3f(x - h, y - h, m_particleDepth);
+        rlVertex3f(x - h, y + h, m_particleDepth);
+        rlVertex3f(x + h, y + h, m_particleDepth);
+        rlVertex3f(x + h, y - h, m_particleDepth);
+    }
+
+    rlEnd();
+}
+
+void RenderBatch::drawSprites(bool opaque) const
+{
+    rlBegin(RL_QUADS);
+    rlNormal3f(0.0f, 0.0f, 1.0f);
+
+    for (const auto& sprite : m_sprites)
+    {
+        if (sprite.opaque != opaque) continue;
+
+        Color color = outputColor(sprite.color);
+        float u0 = sprite.region.x;
+        float v0 = sprite.region.y;
+        float u1 = sprite.region.x + sprite.region.width;
+        float v1 = sprite.region.y + sprite.region.height;
+        rlColor4ub(color.r, color.g, color.b, color.a);
+
+        rlTexCoord2f(u0, v0);
+        rlVertex3f(sprite.corners[0].x, sprite.corners[0].y, sprite.depth);
+        rlTexCoord2f(u0, v1);
+        rlVertex3f(sprite.corners[1].x, sprite.corners[1].y, sprite.depth);
+        rlTexCoord2f(u1, v1);
+        rlVertex3f(sprite.corners[2].x, sprite.corners[2].y, sprite.depth);
+        rlTexCoord2f(u1, v0);
+        rlVertex3f(sprite.corners[3].x, sprite.corners[3].y, sprite.depth);
+    }
+
+    rlEnd();
+}
+
+void RenderBatch::drawTriangles(bool opaque) const
+{
+    // Untextured, sample the white texels of the bound atlas
+    Rectangle white = m_atlas->getRegion(SpriteId::White);
+    float u = white.x + white.width / 2;
+    float v = white.y + white.height / 2;
+
+    rlBegin(RL_TRIANGLES);
+
+    for (const auto& triangle : m_triangles)
+    {
+        if ((triangle.color.a == 255) != opaque) continue;
+
+        Color color = outputColor(triangle.color);
+        rlColor4ub(color.r, color.g, color.b, color.a);
+
+        for (const auto& point : triangle.points)
+        {
+            rlTexCoord2f(u, v);
+            rlVertex3f(point.x, point.y, triangle.depth);
+        }
+    }
+
+    rlEnd();
+}
\ No newline at end of file
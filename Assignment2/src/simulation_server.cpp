@@ -0,0 +1,252 @@
+// simulation_server.cpp
+
+#include "simulation_server.hpp"
+#include "input_recorder.hpp"
+#include "memory_tracker.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <iterator>
+#include <thread>
+
+bool SimulationServer::initialize(int port, int screenWidth, int screenHeight)
+{
+    if (!m_listener.listen(port)) return false;
+
+    // Same world as a local run with the default seed
+    SetRandomSeed(InputRecorder::DEFAULT_SEED);
+    m_worldSize = { (float)(WORLD_CELL_COUNT * WORLD_CELL_SIZE), (float)(WORLD_CELL_COUNT * WORLD_CELL_SIZE) };
+    if (!m_grid.initialize(WORLD_CELL_COUNT, WORLD_CELL_COUNT, WORLD_CELL_SIZE, WORLD_CELL_SIZE, screenWidth, screenHeight)) return false;
+    m_grid.generateAsteroids(6000);
+
+    m_cellCounts.resize(m_grid.getWidth() * m_grid.getHeight());
+    for (int i = 0; i < (int)m_cellCounts.size(); i++)
+    {
+        m_cellCounts[i] = m_grid.getAsteroidCount(i);
+    }
+
+    // The player is clamped against the frame of a local main camera
+    Vector2 screenSize = { (float)screenWidth, (float)screenHeight };
+    m_player.initialize({ m_worldSize.x / 2.0f, m_worldSize.y / 2.0f });
+    GameCamera mainCamera;
+    mainCamera.initialize(m_player.getPosition(), screenSize, m_worldSize, screenSize);
+    m_player.setViewParameter(m_worldSize, mainCamera.getCameraFrame());
+
+    m_tick = 0;
+    std::cout << "Simulation server listening on port " << port << std::endl;
+    return true;
+}
+
+void SimulationServer::shutdown()
+{
+    // Servers are sized by memory, report the footprint of this run
+    MemoryTracker::report(std::cout);
+
+    m_clients.clear();
+    m_listener.close();
+}
+
+void SimulationServer::run(int tickCount)
+{
+    const auto tickDuration = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(InputRecorder::FIXED_TIMESTEP));
+    auto nextTick = std::chrono::steady_clock::now();
+
+    for (int i = 0; tickCount == 0 || i < tickCount; i++)
+    {
+        tick();
+
+        // Sleep away the rest of the tick, do not try to catch up after a stall
+        nextTick += tickDuration;
+        auto now = std::chrono::steady_clock::now();
+        if (nextTick < now) nextTick = now;
+        std::this_thread::sleep_until(nextTick);
+    }
+}
+
+void SimulationServer::tick()
+{
+    auto start = std::chrono::steady_clock::now();
+
+    acceptClients();
+    for (auto& client : m_clients)
+    {
+        receiveMessages(client);
+    }
+
+    // Drop clients whose connection is gone
+    m_clients.erase(std::remove_if(m_clients.begin(), m_clients.end(), [](const Client& client) {
+        if (!client.socket.isOpen()) std::cout << "Client disconnected" << std::endl;
+        return !client.socket.isOpen();
+    }), m_clients.end());
+
+    simulate();
+    sendSnapshots();
+    m_tick++;
+
+    m_workSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (m_tick % REPORT_INTERVAL == 0) report();
+}
+
+void SimulationServer::acceptClients()
+{
+    Client client;
+    while (m_listener.accept(client.socket))
+    {
+        // One frustum per client goes into a single grid traversal
+        if ((int)m_clients.size() >= WorldGrid::MAX_CAMERAS)
+        {
+            std::cerr << "Rejecting client, at most " << WorldGrid::MAX_CAMERAS << " are supported" << std::endl;
+            client.socket.close();
+            continue;
+        }
+
+        std::cout << "Client connected" << std::endl;
+        m_clients.push_back(std::move(client));
+        client = Client();
+    }
+}
+
+void SimulationServer::receiveMessages(Client& client)
+{
+    std::vector<unsigned char> message;
+    while (client.socket.receiveMessage(message))
+    {
+        switch (NetProtocol::getType(message))
+        {
+        case NetProtocol::MessageType::Hello:
+        {
+            Vector2 viewportSize;
+            if (client.ready || !NetProtocol::readHello(message, viewportSize)) break;
+
+            // The client starts its camera from the same position, so both cameras cull the same frustum
+            client.camera.initialize(m_player.getPosition(), viewportSize, m_worldSize, viewportSize);
+            client.ready = true;
+            NetProtocol::writeWelcome(m_message, m_worldSize, m_player.getPosition(), m_cellCounts);
+            client.socket.sendMessage(m_message);
+            break;
+        }
+
+        case NetProtocol::MessageType::Input:
+            NetProtocol::readInput(message, client.input);
+            break;
+
+        default:
+            std::cerr << "Dropping client after an unexpected message" << std::endl;
+            client.socket.close();
+            return;
+        }
+    }
+}
+
+void SimulationServer::simulate()
+{
+    // Every client can steer, the held keys of all of them are combined
+    unsigned char input = 0;
+    for (const auto& client : m_clients)
+    {
+        if (client.ready) input |= client.input & INPUT_PLAYER_CONTROLS;
+    }
+
+    if (input & INPUT_THRUST) m_player.applyThrust();
+    if (input & INPUT_ROTATE_LEFT) m_player.rotateLeft(InputRecorder::FIXED_TIMESTEP);
+    if (input & INPUT_ROTATE_RIGHT) m_player.rotateRight(InputRecorder::FIXED_TIMESTEP);
+
+    m_player.update();
+    m_grid.updateAsteroids();
+}
+
+void SimulationServer::sendSnapshots()
+{
+    // Interest management: cull every ready client's camera in one traversal of the grid
+    m_frusta.clear();
+    m_frustumClients.clear();
+    for (int i = 0; i < (int)m_clients.size(); i++)
+    {
+        Client& client = m_clients[i];
+        if (!client.ready) continue;
+
+        // The camera moves every tick, also for a client that skips it
+        client.camera.update(m_player.getPosition());
+
+        // A failed connection is removed at the next tick
+        if (!client.socket.flush()) continue;
+
+        // The previous snapshot is still queued: skip this tick, the next snapshot is the
+        // difference to what the client has been sent, so it carries this tick's changes too
+        if (client.socket.getPendingBytes() > 0)
+        {
+            client.resync = true;
+            if (++client.stalledTicks > MAX_STALLED_TICKS)
+            {
+                std::cerr << "Dropping client stalled for " << client.stalledTicks << " ticks" << std::endl;
+                client.socket.close();
+            }
+            continue;
+        }
+        client.stalledTicks = 0;
+
+        m_frusta.push_back(client.camera.getFrustum());
+        m_frustumClients.push_back(i);
+    }
+
+    if (m_frusta.empty()) return;
+    m_grid.getVisibleAsteroidIds(m_frusta, m_visibleIds);
+
+    for (size_t f = 0; f < m_frusta.size(); f++)
+    {
+        Client& client = m_clients[m_frustumClients[f]];
+        std::vector<unsigned int>& visible = m_visibleIds[f];
+
+        // Both id lists are sorted, the delta is two linear set differences
+        m_snapshot.tick = m_tick;
+        m_snapshot.playerPosition = m_player.getPosition();
+        m_snapshot.playerRotation = m_player.getRotation();
+        m_snapshot.hasCamera = client.resync;
+        m_snapshot.cameraPosition = client.camera.getPosition();
+        m_snapshot.cameraFrame = client.camera.getCameraFrame();
+        m_snapshot.left.clear();
+        std::set_difference(client.knownIds.begin(), client.knownIds.end(), visible.begin(), visible.end(),
+            std::back_inserter(m_snapshot.left));
+
+        m_snapshot.entered.clear();
+        auto known = client.knownIds.begin();
+        for (unsigned int id : visible)
+        {
+            while (known != client.knownIds.end() && *known < id) ++known;
+            if (known != client.knownIds.end() && *known == id) continue;
+
+            m_snapshot.entered.push_back({ id, m_grid.getAsteroid(id) });
+        }
+
+        NetProtocol::writeSnapshot(m_message, m_snapshot, m_worldSize);
+        if (!client.socket.sendMessage(m_message)) continue;
+
+        client.knownIds.swap(visible);
+        client.resync = false;
+        client.snapshotBytes += m_message.size();
+        client.snapshots++;
+    }
+}
+
+void SimulationServer::report()
+{
+    std::cout << "Tick " << m_tick << ": " << m_clients.size() << " clients, "
+        << m_workSeconds * 1000.0 / REPORT_INTERVAL << " ms work per tick" << std::endl;
+
+    for (size_t i = 0; i < m_clients.size(); i++)
+    {
+        Client& client = m_clients[i];
+        if (client.snapshots == 0) continue;
+
+        double bytesPerTick = (double)client.snapshotBytes / client.snapshots;
+        std::cout << "  client " << i << ": " << client.knownIds.size() << " visible, "
+            << bytesPerTick << " bytes per snapshot, "
+            << bytesPerTick / InputRecorder::FIXED_TIMESTEP / 1024.0 << " KiB/s" << std::endl;
+
+        client.snapshotBytes = 0;
+        client.snapshots = 0;
+    }
+
+    m_workSeconds = 0.0;
+}
\ No newline at end of file
@@ -0,0 +1,210 @@
+// sprite_atlas.cpp
+
+#include "sprite_atlas.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+namespace
+{
+    // Indexed by SpriteId, an empty path is generated instead of loaded
+    const char* SPRITE_PATHS[] = {
+        "",
+        "assets/player_plane.png",
+        "assets/face.bmp"
+    };
+
+    const int WHITE_SIZE = 4;
+}
+
+void SpriteAtlas::startLoading()
+{
+    m_ready = false;
+    m_loadStartTime = GetTime();
+    m_loading = std::async(std::launch::async, &SpriteAtlas::loadImages);
+}
+
+void SpriteAtlas::shutdown()
+{
+    // Wait for the worker and release images that were never packed
+    if (m_loading.valid())
+    {
+        for (auto& loaded : m_loading.get())
+        {
+            UnloadImage(loaded.image);
+        }
+    }
+
+    if (m_ready) UnloadTexture(m_texture);
+    m_ready = false;
+}
+
+void SpriteAtlas::update()
+{
+    if (m_ready || !m_loading.valid()) return;
+    if (m_loading.wait_for(std::chrono::seconds(0)) != std::future_status::ready) return;
+
+    std::vector<LoadedImage> images = m_loading.get();
+    pack(images);
+
+    for (auto& loaded : images)
+    {
+        UnloadImage(loaded.image);
+    }
+}
+
+Texture2D SpriteAtlas::getTexture() const
+{
+    return m_ready ? m_texture : GetShapesTexture();
+}
+
+Rectangle SpriteAtlas::getRegion(SpriteId sprite) const
+{
+    if (m_ready) return m_regions[(int)sprite].uv;
+
+    Texture2D shapesTexture = GetShapesTexture();
+    Rectangle shapesRect = GetShapesTextureRectangle();
+    return {
+        shapesRect.x / shapesTexture.width,
+        shapesRect.y / shapesTexture.height,
+        shapesRect.width / shapesTexture.width,
+        shapesRect.height / shapesTexture.height
+    };
+}
+
+float SpriteAtlas::getAspectRatio(SpriteId sprite) const
+{
+    return m_regions[(int)sprite].aspectRatio;
+}
+
+bool SpriteAtlas::isOpaque(SpriteId sprite) const
+{
+    return !m_ready || m_regions[(int)sprite].opaque;
+}
+
+std::vector<SpriteAtlas::LoadedImage> SpriteAtlas::loadImages()
+{
+    // Runs on the worker thread: only CPU side image functions, no GPU calls
+    std::vector<LoadedImage> images((int)SpriteId::Count);
+
+    for (int i = 0; i < (int)SpriteId::Count; i++)
+    {
+        Image& image = images[i].image;
+
+        if (SPRITE_PATHS[i][0] == '\0')
+        {
+            image = GenImageColor(WHITE_SIZE, WHITE_SIZE, WHITE);
+            continue;
+        }
+
+        image = LoadImage(SPRITE_PATHS[i]);
+        if (image.data == nullptr)
+        {
+            // A missing sprite becomes a small magenta square so it is easy to spot
+            std::cerr << "Failed to load sprite " << SPRITE_PATHS[i] << std::endl;
+            image = GenImageColor(WHITE_SIZE, WHITE_SIZE, MAGENTA);
+            continue;
+        }
+
+        ImageFormat(&image, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+
+        // Sprites are drawn a few dozen pixels large, keep at most MAX_SPRITE_SIZE texels per side
+        int largest = std::max(image.width, image.height);
+        if (largest > MAX_SPRITE_SIZE)
+        {
+            ImageResize(&image,
+                std::max(1, image.width * MAX_SPRITE_SIZE / largest),
+                std::max(1, image.height * MAX_SPRITE_SIZE / largest));
+        }
+
+        const unsigned char* pixels = (const unsigned char*)image.data;
+        for (int p = 0; p < image.width * image.height; p++)
+        {
+            if (pixels[p * 4 + 3] != 255)
+            {
+                images[i].opaque = false;
+                break;
+            }
+        }
+    }
+
+    return images;
+}
+
+void SpriteAtlas::pack(std::vector<LoadedImage>& images)
+{
+    // Shelf packing: tallest images first, filling rows left to right
+    std::vector<int> order(images.size());
+    for (size_t i = 0; i < order.size(); i++) order[i] = (int)i;
+    std::sort(order.begin(), order.end(), [&](int a, int b) {
+        return images[a].image.height > images[b].image.height;
+    });
+
+    int atlasWidth = 64;
+    for (const auto& loaded : images)
+    {
+        while (atlasWidth < loaded.image.width + 2 * PADDING) atlasWidth *= 2;
+    }
+
+    std::vector<Rectangle> placements(images.size());
+    int shelfX = 0, shelfY = 0, shelfHeight = 0;
+    for (int i : order)
+    {
+        const Image& image = images[i].image;
+        if (shelfX + image.width + 2 * PADDING > atlasWidth)
+        {
+            shelfY += shelfHeight;
+            shelfX = 0;
+            shelfHeight = 0;
+        }
+
+        placements[i] = { (float)(shelfX + PADDING), (float)(shelfY + PADDING), (float)image.width, (float)image.height };
+        shelfX += image.width + 2 * PADDING;
+        shelfHeight = std::max(shelfHeight, image.height + 2 * PADDING);
+    }
+
+    int atlasHeight = 64;
+    while (atlasHeight < shelfY + shelfHeight) atlasHeight *= 2;
+
+    // Copy the rows of every sprite into the atlas image
+    Image atlas = GenImageColor(atlasWidth, atlasHeight, BLANK);
+    unsigned char* atlasPixels = (unsigned char*)atlas.data;
+    for (size_t i = 0; i < images.size(); i++)
+    {
+        const Image& image = images[i].image;
+        const unsigned char* pixels = (const unsigned char*)image.data;
+        int x = (int)placements[i].x;
+        int y = (int)placements[i].y;
+
+        for (int row = 0; row < image.height; row++)
+        {
+            memcpy(atlasPixels + ((y + row) * atlasWidth + x) * 4, pixels + row * image.width * 4, image.width * 4);
+        }
+
+        Region& region = m_regions[i];
+        region.uv = {
+            placements[i].x / atlasWidth,
+            placements[i].y / atlasHeight,
+            placements[i].width / atlasWidth,
+            placements[i].height / atlasHeight
+        };
+        region.aspectRatio = placements[i].width / placements[i].height;
+        region.opaque = images[i].opaque;
+    }
+
+    // Untextured shapes sample the middle of the white block, away from its filtered edges
+    Rectangle& white = m_regions[(int)SpriteId::White].uv;
+    white.x += 1.0f / atlasWidth;
+    white.y += 1.0f / atlasHeight;
+    white.width = (WHITE_SIZE - 2.0f) / atlasWidth;
+    white.height = (WHITE_SIZE - 2.0f) / atlasHeight;
+
+    m_texture = LoadTextureFromImage(atlas);
+    UnloadImage(atlas);
+    SetTextureFilter(m_texture, TEXTURE_FILTER_BILINEAR);
+    m_ready = true;
+
+    std::cout << "Sprite atlas " << atlasWidth << "x" << atlasHeight << " with " << images.size()
+        << " sprites ready after " << (GetTime() - m_loadStartTime) * 1000.0 << " ms" << std::endl;
+}
\ No newline at end of file
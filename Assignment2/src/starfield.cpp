@@ -3,11 +3,18 @@
 #include "starfield.hpp"
 #include "math_utils.hpp"
 #include <raylib.h>
+#include <algorithm>
 
-void Starfield::initialize(int worldWidth, int worldHeight)
+void Starfield::initialize(int worldWidth, int worldHeight, float rasterScale)
 {
     m_screenWidth = worldWidth;
     m_screenHeight = worldHeight;
+    m_rasterScale = rasterScale;
+
+    m_tilesX = (worldWidth + TILE_SIZE - 1) / TILE_SIZE;
+    m_tilesY = (worldHeight + TILE_SIZE - 1) / TILE_SIZE;
+    m_tiles.assign(m_tilesX * m_tilesY, Tile());
+    m_cachedTileCount = 0;
 
     m_stars.resize(STAR_COUNT);
 
@@ -28,27 +35,185 @@ void Starfield::initialize(int worldWidth, int worldHeight)
         // Random parallax factor (0.1 - 0.9)
         star.parallaxFactor = MathUtils::random(0.1f, 0.9f);
     }
+
+    // Sort stars by tile so each tile rasterizes a contiguous range
+    auto tileOf = [this](const Star& star) {
+        int tileX = std::min(m_tilesX - 1, (int)star.position.x / TILE_SIZE);
+        int tileY = std::min(m_tilesY - 1, (int)star.position.y / TILE_SIZE);
+        return tileY * m_tilesX + tileX;
+    };
+
+    std::sort(m_stars.begin(), m_stars.end(),
+        [&tileOf](const Star& a, const Star& b) {
+            return tileOf(a) < tileOf(b);
+        });
+
+    m_tileFirstStar.assign(m_tiles.size() + 1, 0);
+    for (const auto& star : m_stars)
+    {
+        m_tileFirstStar[tileOf(star) + 1]++;
+    }
+    for (size_t i = 1; i < m_tileFirstStar.size(); i++)
+    {
+        m_tileFirstStar[i] += m_tileFirstStar[i - 1];
+    }
+
+    m_usage.set(getUsedBytes());
 }
 
-void Starfield::addRenderCommands(std::vector<RenderCommand>& commands, const GameCamera& camera)
+void Starfield::shutdown()
+{
+    for (auto& tile : m_tiles)
+    {
+        if (tile.cached) UnloadRenderTexture(tile.texture);
+        tile.cached = false;
+    }
+    m_cachedTileCount = 0;
+}
+
+void Starfield::setDensity(float density)
+{
+    density = std::clamp(density, 0.0f, 1.0f);
+    if (density == m_density) return;
+    m_density = density;
+
+    // Release every tile, the visible ones are rasterized with the new density by the next update
+    shutdown();
+}
+
+void Starfield::updateTiles(const std::vector<Rectangle>& frusta)
+{
+    m_frame++;
+
+    // Mark every visible tile as used this frame before releasing any
+    for (const auto& frustum : frusta)
+    {
+        getVisibleTiles(frustum, m_visibleTiles);
+        for (int index : m_visibleTiles)
+        {
+            m_tiles[index].lastUsedFrame = m_frame;
+        }
+    }
+
+    for (const auto& frustum : frusta)
+    {
+        getVisibleTiles(frustum, m_visibleTiles);
+        for (int index : m_visibleTiles)
+        {
+            if (m_tiles[index].cached) continue;
+
+            if (m_cachedTileCount >= MAX_CACHED_TILES) releaseLeastRecentlyUsedTile();
+            rasterizeTile(index);
+        }
+    }
+}
+
+void Starfield::render(const GameCamera& camera) const
 {
     Rectangle frustum = camera.getFrustum();
+    Rectangle cameraFrame = camera.getCameraFrame();
+    Vector2 viewportSize = camera.getViewportSize();
 
-    for (const auto& star : m_stars)
+    // Size of one tile on screen
+    float tileWidth = TILE_SIZE * cameraFrame.width / viewportSize.x;
+    float tileHeight = TILE_SIZE * cameraFrame.height / viewportSize.y;
+
+    int startX, endX, startY, endY;
+    getTileRange(frustum, startX, endX, startY, endY);
+
+    for (int y = startY; y <= endY; y++)
     {
-        // Check if star is within the camera frustum
-        if (star.position.x >= frustum.x && star.position.x <= frustum.x + frustum.width &&
-            star.position.y >= frustum.y && star.position.y <= frustum.y + frustum.height)
+        for (int x = startX; x <= endX; x++)
         {
-            RenderCommand cmd;
-            cmd.type = RenderCommandType::Star;
-            cmd.position = star.position; // Use world coordinates
-            cmd.size = { star.size, star.size };
-            cmd.rotation = 0;
-            cmd.color = star.color;
-            cmd.layer = 0;
-
-            commands.push_back(cmd);
+            const Tile& tile = m_tiles[y * m_tilesX + x];
+            if (!tile.cached) continue;
+
+            Vector2 screenPos = camera.worldToScreen({ (float)(x * TILE_SIZE), (float)(y * TILE_SIZE) });
+
+            // Render textures are stored upside down, flip the source rectangle
+            Rectangle source = { 0, 0, (float)tile.texture.texture.width, -(float)tile.texture.texture.height };
+            Rectangle dest = { screenPos.x, screenPos.y, tileWidth, tileHeight };
+            DrawTexturePro(tile.texture.texture, source, dest, { 0, 0 }, 0.0f, WHITE);
         }
     }
+}
+
+void Starfield::getVisibleTiles(const Rectangle& frustum, std::vector<int>& tiles) const
+{
+    tiles.clear();
+
+    int startX, endX, startY, endY;
+    getTileRange(frustum, startX, endX, startY, endY);
+
+    for (int y = startY; y <= endY; y++)
+    {
+        for (int x = startX; x <= endX; x++)
+        {
+            tiles.push_back(y * m_tilesX + x);
+        }
+    }
+}
+
+void Starfield::getTileRange(const Rectangle& frustum, int& startX, int& endX, int& startY, int& endY) const
+{
+    startX = std::max(0, (int)frustum.x / TILE_SIZE);
+    endX = std::min(m_tilesX - 1, (int)(frustum.x + frustum.width) / TILE_SIZE);
+    startY = std::max(0, (int)frustum.y / TILE_SIZE);
+    endY = std::min(m_tilesY - 1, (int)(frustum.y + frustum.height) / TILE_SIZE);
+}
+
+void Starfield::rasterizeTile(int index)
+{
+    Tile& tile = m_tiles[index];
+    int texels = (int)(TILE_SIZE * m_rasterScale);
+    tile.texture = LoadRenderTexture(texels, texels);
+    tile.cached = true;
+    m_cachedTileCount++;
+
+    Vector2 origin = {
+        (float)(index % m_tilesX * TILE_SIZE),
+        (float)(index / m_tilesX * TILE_SIZE)
+    };
+
+    BeginTextureMode(tile.texture);
+    ClearBackground(BLANK);
+
+    // Stars within a tile are in random order, so a prefix is an even thinning
+    int first = m_tileFirstStar[index];
+    int last = first + (int)((m_tileFirstStar[index + 1] - first) * m_density);
+    for (int i = first; i < last; i++)
+    {
+        const Star& star = m_stars[i];
+
+        // Stars are centered on their position, like the other world objects
+        float size = star.size * m_rasterScale;
+        Rectangle rect = {
+            (star.position.x - origin.x) * m_rasterScale - size / 2,
+            (star.position.y - origin.y) * m_rasterScale - size / 2,
+            size,
+            size
+        };
+        DrawRectangleRec(rect, star.color);
+    }
+
+    EndTextureMode();
+}
+
+void Starfield::releaseLeastRecentlyUsedTile()
+{
+    int oldest = -1;
+    for (int i = 0; i < (int)m_tiles.size(); i++)
+    {
+        const Tile& tile = m_tiles[i];
+        if (!tile.cached || tile.lastUsedFrame == m_frame) continue;
+
+        if (oldest < 0 || tile.lastUsedFrame < m_tiles[oldest].lastUsedFrame) oldest = i;
+    }
+
+    // Every cached tile is visible this frame, let the cache grow instead
+    if (oldest < 0) return;
+
+    UnloadRenderTexture(m_tiles[oldest].texture);
+    m_tiles[oldest].cached = false;
+    m_cachedTileCount--;
 }
\ No newline at end of file